@@ -13,6 +13,10 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/bdd_bu_tree_aut.hh>
+
+// standard library headers
+#include <type_traits>
 
 // local headers
 #include "parse_args.hh"
@@ -125,6 +129,22 @@ bool CheckInclusion(Automaton smaller, Automaton bigger, const Arguments& args)
 	}
 	else { throw optErrorEx; }
 
+	if (options.count("threads"))
+	{
+		ip.SetThreadCount(Convert::FromString<size_t>(options["threads"]));
+
+		// only the upward inclusion on 'bdd-bu' is parallel
+		if ((1 != ip.GetThreadCount()) &&
+			(!std::is_same<Automaton, VATA::BDDBottomUpTreeAut>::value ||
+			(InclParam::e_algorithm::antichains != ip.GetAlgorithm()) ||
+			(InclParam::e_direction::upward != ip.GetDirection()) ||
+			ip.GetUseSimulation()))
+		{
+			throw std::runtime_error("The option 'threads' is only supported for "
+				"upward inclusion without simulation on 'bdd-bu'");
+		}
+	}
+
 	/****************************************************************************
 	 *                            Additional handling
 	 ****************************************************************************/
@@ -229,6 +249,11 @@ VATA::AutBase::StateBinaryRelation ComputeSimulation(
 			Convert::ToString(options));
 	}
 
+	if (options.count("threads"))
+	{
+		sp.SetThreadCount(Convert::FromString<size_t>(options["threads"]));
+	}
+
 	return aut.ComputeSimulation(sp);
 }
 
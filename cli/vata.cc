@@ -84,6 +84,7 @@ const char VATA_USAGE_COMMANDS[] =
 	"\n"
 	"          'dir=down' : downward simulation (default)\n"
 	"          'dir=up'   : upward simulation\n"
+	"          'threads=N': use N threads (0 for all cores, default 1)\n"
 	"\n"
 	"    red <file>              Reduces the automaton in <file> using simulation\n"
 	"                            relation. Options:\n"
@@ -115,6 +116,8 @@ const char VATA_USAGE_COMMANDS[] =
 	"          'rec=yes'  : non-recursive version of the algorithm\n"
 	"          'timeS=yes': include time of simulation computation (default)\n"
 	"          'timeS=no' : do not include time of simulation computation\n"
+	"          'threads=N': use N threads (0 for all cores, default 1); only\n"
+	"                       supported by 'dir=up' and 'sim=no' on 'bdd-bu'\n"
 	;
 
 const char VATA_USAGE_FLAGS[] =
@@ -20,6 +20,7 @@
 
 // Utilities
 #include <vata/util/binary_relation.hh>
+#include <vata/util/small_vector.hh>
 #include <vata/util/two_way_dict.hh>
 #include <vata/util/transl_weak.hh>
 #include <vata/util/transl_strict.hh>
@@ -99,12 +100,14 @@ public:   // methods
 		StateToStateTranslWeak stateTrans(stateMap,
 			[&stateCnt](const StateType&){return stateCnt++;});
 
-		Automaton tmpAut = smaller.RemoveUselessStates();
-		Automaton newSmaller = tmpAut.ReindexStates(stateTrans);
+		// each automaton is processed in its own environment, so the temporary
+		// automata are not shared
+		Automaton tmpSmaller = smaller.RemoveUselessStates();
+		Automaton newSmaller = tmpSmaller.ReindexStates(stateTrans);
 
-		tmpAut = bigger.RemoveUselessStates();
+		Automaton tmpBigger = bigger.RemoveUselessStates();
 		stateMap.clear();
-		Automaton newBigger = tmpAut.ReindexStates(stateTrans);
+		Automaton newBigger = tmpBigger.ReindexStates(stateTrans);
 
 		smaller = newSmaller;
 		bigger = newBigger;
@@ -124,7 +127,12 @@ protected:// methods
 
 public:   // data types
 
-	using StateTuple     = std::vector<StateType>;
+	/**
+	 * @brief  Tuple of states of the left-hand side of a transition
+	 *
+	 * Tuples of rank up to 3 are stored inline, without heap allocation.
+	 */
+	using StateTuple     = Util::SmallVector<StateType, 3>;
 
 protected:// data types
 
@@ -15,6 +15,7 @@
 #include <vata/vata.hh>
 #include <vata/aut_base.hh>
 #include <vata/bdd_td_tree_aut.hh>
+#include <vata/explicit_tree_aut.hh>
 #include <vata/symbolic.hh>
 #include <vata/notimpl_except.hh>
 #include <vata/incl_param.hh>
@@ -44,6 +45,17 @@ class VATA::BDDBottomUpTreeAut : public SymbolicTreeAutBase
 {
 GCC_DIAG_ON(effc++)
 
+public:   // data types
+
+	/**
+	 * @brief  Encoding of symbols of explicit automata
+	 *
+	 * Maps a symbol of ExplicitTreeAut to the assignment of Boolean variables
+	 * representing it in MTBDDs.
+	 */
+	using ExplicitSymbolEncoding =
+		std::unordered_map<ExplicitTreeAut::SymbolType, SymbolType>;
+
 private:  // data types
 
 	using CoreAut        = VATA::LoadableAut<BDDBUTreeAutCore>;
@@ -246,6 +258,39 @@ public:   // methods
 	BDDTopDownTreeAut GetTopDownAut() const;
 
 
+	/**
+	 * @brief  Converts an explicit automaton
+	 *
+	 * The transitions of @p aut are streamed directly into MTBDDs, without
+	 * going through AutDescription. States are kept, symbols are translated
+	 * using @p encoding.
+	 *
+	 * @param[in]  aut       The explicit automaton
+	 * @param[in]  encoding  Encoding of all symbols used in @p aut
+	 *
+	 * @returns  The automaton with the same transitions as @p aut
+	 *
+	 * @throws  std::out_of_range  If a symbol of @p aut is not encoded
+	 */
+	static BDDBottomUpTreeAut FromExplicit(
+		const ExplicitTreeAut&            aut,
+		const ExplicitSymbolEncoding&     encoding);
+
+
+	/**
+	 * @brief  Converts the automaton to an explicit automaton
+	 *
+	 * Only the symbols of @p encoding are taken into account, transitions
+	 * over other assignments of the Boolean variables are dropped.
+	 *
+	 * @param[in]  encoding  Encoding of the symbols of the explicit automaton
+	 *
+	 * @returns  The explicit automaton with the same states
+	 */
+	ExplicitTreeAut ToExplicit(
+		const ExplicitSymbolEncoding&     encoding) const;
+
+
 	BDDBottomUpTreeAut Reduce() const
 	{
 		throw NotImplementedException(__func__);
@@ -15,6 +15,7 @@
 #include <vata/vata.hh>
 #include <vata/symbolic.hh>
 #include <vata/bdd_bu_tree_aut.hh>
+#include <vata/explicit_tree_aut.hh>
 #include <vata/notimpl_except.hh>
 #include <vata/incl_param.hh>
 #include <vata/sim_param.hh>
@@ -56,6 +57,16 @@ GCC_DIAG_ON(effc++)
 
 	friend VATA::BDDBottomUpTreeAut;
 
+public:   // data types
+
+	/**
+	 * @brief  Encoding of symbols of explicit automata
+	 *
+	 * @see  BDDBottomUpTreeAut::ExplicitSymbolEncoding
+	 */
+	using ExplicitSymbolEncoding =
+		std::unordered_map<ExplicitTreeAut::SymbolType, SymbolType>;
+
 private:  // data types
 
 	using CoreAut        = VATA::LoadableAut<BDDTDTreeAutCore>;
@@ -229,6 +240,25 @@ public:   // public methods
 		const BDDTopDownTreeAut&      lhs,
 		const BDDTopDownTreeAut&      rhs,
 		AutBase::ProductTranslMap*    pTranslMap = nullptr);
+
+
+	/**
+	 * @brief  Converts an explicit automaton
+	 *
+	 * @see  BDDBottomUpTreeAut::FromExplicit()
+	 */
+	static BDDTopDownTreeAut FromExplicit(
+		const ExplicitTreeAut&        aut,
+		const ExplicitSymbolEncoding& encoding);
+
+
+	/**
+	 * @brief  Converts the automaton to an explicit automaton
+	 *
+	 * @see  BDDBottomUpTreeAut::ToExplicit()
+	 */
+	ExplicitTreeAut ToExplicit(
+		const ExplicitSymbolEncoding& encoding) const;
 };
 
 #endif
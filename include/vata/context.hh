@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Header file for the context of automata.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_CONTEXT_HH_
+#define _VATA_CONTEXT_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/explicit_tree_aut.hh>
+
+// Standard library headers
+#include <functional>
+#include <memory>
+
+
+namespace VATA
+{
+	class Context;
+
+	namespace Util
+	{
+		template <
+			class,
+			class>
+		class Cache;
+	}
+}
+
+
+/**
+ * @brief  Context of automata
+ *
+ * A context holds the data structures that automata would otherwise share
+ * through global (static) variables, i.e., the cache of tuples of states and
+ * the alphabet of explicit tree automata. Automata constructed with a context
+ * use only the data of the context, so automata of different contexts can be
+ * processed by different threads without any synchronisation. Automata of
+ * the same context must not be used by several threads at once.
+ *
+ * The unique tables of MTBDDs (used by symbolic automata) are kept per thread,
+ * so MTBDD-based automata need to be created and used by a single thread.
+ *
+ * A context needs to outlive all automata that were constructed with it.
+ */
+GCC_DIAG_OFF(effc++)
+class VATA::Context
+{
+GCC_DIAG_ON(effc++)
+
+public:   // data types
+
+	using ExplicitTreeTupleCache    = Util::Cache<TreeAutBase::StateTuple,
+		std::function<void(const TreeAutBase::StateTuple*)>>;
+	using ExplicitTreeAlphabetType  = ExplicitTreeAut::AlphabetType;
+
+private:  // data members
+
+	std::unique_ptr<ExplicitTreeTupleCache> explicitTreeTupleCache_;
+
+	ExplicitTreeAlphabetType explicitTreeAlphabet_;
+
+private:  // methods
+
+	Context(const Context&);
+	Context& operator=(const Context&);
+
+public:   // methods
+
+	Context();
+
+	~Context();
+
+	/**
+	 * @brief  Retrieves the cache of tuples for explicit tree automata
+	 */
+	ExplicitTreeTupleCache& GetExplicitTreeTupleCache();
+
+	/**
+	 * @brief  Retrieves the alphabet for explicit tree automata
+	 */
+	ExplicitTreeAlphabetType& GetExplicitTreeAlphabet();
+};
+
+#endif
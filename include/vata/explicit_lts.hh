@@ -11,6 +11,11 @@
 #ifndef _VATA_EXPLICIT_LTS_HH_
 #define _VATA_EXPLICIT_LTS_HH_
 
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
 #include <vector>
 
 #include <vata/util/binary_relation.hh>
@@ -19,118 +24,273 @@
 
 namespace VATA { class ExplicitLTS; }
 
+/**
+ * @brief  A labelled transition system
+ *
+ * Transitions are first collected using addTransition(); init() then builds
+ * a compressed sparse row representation of both the successor and the
+ * predecessor relation. The rows are indexed by (label, state) pairs in the
+ * label-major order and refer to a single array of 32-bit states, so that the
+ * successors (predecessors) of a state under a label form a contiguous range
+ * that preserves the order of insertion. The labels of incoming transitions of
+ * every state are stored in the same way.
+ *
+ * Row indices are computed in @p size_t, the 32-bit offsets only need to
+ * address the transitions, so the number of (label, state) pairs is not
+ * limited by the width of Index. States, labels and the number of
+ * transitions need to fit into Index; std::length_error is thrown otherwise.
+ */
 class VATA::ExplicitLTS {
 
+public:
+
+	typedef uint32_t Index;
+
+	/**
+	 * @brief  A contiguous range of states (or labels)
+	 */
+	class Row {
+
+		const Index* begin_;
+		const Index* end_;
+
+	public:
+
+		Row(const Index* begin, const Index* end) : begin_(begin), end_(end) {}
+
+		const Index* begin() const { return this->begin_; }
+
+		const Index* end() const { return this->end_; }
+
+		size_t size() const { return this->end_ - this->begin_; }
+
+		bool empty() const { return this->begin_ == this->end_; }
+
+		const Index& operator[](size_t i) const {
+
+			assert(i < this->size());
+
+			return this->begin_[i];
+
+		}
+
+	};
+
+private:
+
+	struct Transition {
+
+		Index q;
+		Index a;
+		Index r;
+
+		Transition(size_t q, size_t a, size_t r) : q(q), a(a), r(r) {}
+
+	};
+
 	size_t states_;
-	size_t transitions_;
-	std::vector<
-		std::pair<
-			std::vector<std::vector<size_t>>,
-			std::vector<std::vector<size_t>>
-		>
-	> data_;
-	std::vector<Util::SmartSet> bwLabels_;
+	size_t labels_;
+	std::vector<Transition> transitions_;
+
+	std::vector<Index> postOffsets_;
+	std::vector<Index> postTargets_;
+	std::vector<Index> preOffsets_;
+	std::vector<Index> preTargets_;
+	std::vector<Index> bwLabelOffsets_;
+	std::vector<Index> bwLabels_;
+
+	// counting sort of the transitions into rows given by key(t), the rows
+	// contain value(t)
+	template <class Key, class Value>
+	void buildRows(size_t rows, std::vector<Index>& offsets, std::vector<Index>& targets,
+		Key key, Value value) const {
+
+		offsets.assign(rows + 1, 0);
+
+		for (auto& t : this->transitions_)
+			++offsets[key(t) + 1];
+
+		for (size_t i = 0; i < rows; ++i)
+			offsets[i + 1] += offsets[i];
+
+		targets.resize(this->transitions_.size());
+
+		std::vector<Index> next(offsets.begin(), offsets.end() - 1);
+
+		for (auto& t : this->transitions_)
+			targets[next[key(t)]++] = value(t);
+
+	}
+
+	size_t row(size_t a, size_t q) const {
+
+		assert(a < this->labels_);
+		assert(q < this->states_);
+
+		return a*this->states_ + q;
+
+	}
 
 public:
 
-	ExplicitLTS() : states_(0), transitions_(0), data_(), bwLabels_() {}
+	ExplicitLTS() : states_(0), labels_(0), transitions_(), postOffsets_(),
+		postTargets_(), preOffsets_(), preTargets_(), bwLabelOffsets_(), bwLabels_() {}
 
 	void addTransition(size_t q, size_t a, size_t r) {
-		if (a >= this->data_.size())
-			this->data_.resize(a + 1);
 
-		if (q >= this->data_[a].first.size()) {
-			if (q >= this->states_)
-				this->states_ = q + 1;
-			this->data_[a].first.resize(q + 1);
-		}
+		const size_t maxIndex = std::numeric_limits<Index>::max();
 
-		if (r >= this->data_[a].second.size()) {
-			if (r >= this->states_)
-				this->states_ = r + 1;
-			this->data_[a].second.resize(r + 1);
-		}
+		if ((q >= maxIndex) || (a >= maxIndex) || (r >= maxIndex) ||
+			(this->transitions_.size() >= maxIndex))
+			throw std::length_error("ExplicitLTS: too many states, labels or transitions");
 
-		this->data_[a].first[q].push_back(r);
-		this->data_[a].second[r].push_back(q);
+		if (a >= this->labels_)
+			this->labels_ = a + 1;
 
-		++this->transitions_;
+		if (q >= this->states_)
+			this->states_ = q + 1;
+
+		if (r >= this->states_)
+			this->states_ = r + 1;
+
+		this->transitions_.push_back(Transition(q, a, r));
 
 	}
 
 	void init() {
 
-		this->bwLabels_.resize(this->states_, Util::SmartSet(this->data_.size()));
+		this->buildRows(
+			this->labels_*this->states_, this->postOffsets_, this->postTargets_,
+			[this](const Transition& t){ return this->row(t.a, t.q); },
+			[](const Transition& t){ return t.r; }
+		);
+
+		this->buildRows(
+			this->labels_*this->states_, this->preOffsets_, this->preTargets_,
+			[this](const Transition& t){ return this->row(t.a, t.r); },
+			[](const Transition& t){ return t.q; }
+		);
+
+		// labels of incoming transitions, each listed once per state
+		this->bwLabelOffsets_.assign(this->states_ + 1, 0);
+
+		for (size_t a = 0; a < this->labels_; ++a) {
+
+			for (size_t r = 0; r < this->states_; ++r) {
 
-		for (size_t a = 0; a < this->data_.size(); ++a) {
+				if (!this->pre(a, r).empty())
+					++this->bwLabelOffsets_[r + 1];
 
-			this->data_[a].first.resize(this->states_);
-			this->data_[a].second.resize(this->states_);
+			}
+
+		}
+
+		for (size_t r = 0; r < this->states_; ++r)
+			this->bwLabelOffsets_[r + 1] += this->bwLabelOffsets_[r];
+
+		this->bwLabels_.resize(this->bwLabelOffsets_.back());
+
+		std::vector<Index> next(this->bwLabelOffsets_.begin(), this->bwLabelOffsets_.end() - 1);
+
+		for (size_t a = 0; a < this->labels_; ++a) {
+
+			for (size_t r = 0; r < this->states_; ++r) {
 
-			for (size_t r = 0; r < this->states_; ++r)
-				this->bwLabels_[r].init(a, this->data_[a].second[r].size());
+				if (!this->pre(a, r).empty())
+					this->bwLabels_[next[r]++] = a;
+
+			}
 
 		}
 
+		std::vector<Transition>().swap(this->transitions_);
+
 	}
 
 	void clear() {
 
-		this->data_.clear();
+		this->transitions_.clear();
+		this->postOffsets_.clear();
+		this->postTargets_.clear();
+		this->preOffsets_.clear();
+		this->preTargets_.clear();
+		this->bwLabelOffsets_.clear();
 		this->bwLabels_.clear();
 		this->states_ = 0;
-		this->transitions_ = 0;
+		this->labels_ = 0;
 
 	}
 
-	const std::vector<std::vector<size_t>>& post(size_t a) const {
+	/**
+	 * @brief  The successors of @p q under the label @p a
+	 */
+	Row post(size_t a, size_t q) const {
+
+		size_t i = this->row(a, q);
 
-		assert(a < this->data_.size());
+		assert(i + 1 < this->postOffsets_.size());
 
-		return this->data_[a].first;
+		return Row(
+			this->postTargets_.data() + this->postOffsets_[i],
+			this->postTargets_.data() + this->postOffsets_[i + 1]
+		);
 
 	}
 
-	const std::vector<std::vector<size_t>>& pre(size_t a) const {
+	/**
+	 * @brief  The predecessors of @p r under the label @p a
+	 */
+	Row pre(size_t a, size_t r) const {
+
+		size_t i = this->row(a, r);
 
-		assert(a < this->data_.size());
+		assert(i + 1 < this->preOffsets_.size());
 
-		return this->data_[a].second;
+		return Row(
+			this->preTargets_.data() + this->preOffsets_[i],
+			this->preTargets_.data() + this->preOffsets_[i + 1]
+		);
 
 	}
 
-	const Util::SmartSet& bwLabels(size_t q) const {
+	/**
+	 * @brief  The labels of the transitions leading to @p q (in ascending order)
+	 */
+	Row bwLabels(size_t q) const {
 
-		assert(q < this->bwLabels_.size());
+		assert(q + 1 < this->bwLabelOffsets_.size());
 
-		return this->bwLabels_[q];
+		return Row(
+			this->bwLabels_.data() + this->bwLabelOffsets_[q],
+			this->bwLabels_.data() + this->bwLabelOffsets_[q + 1]
+		);
 
 	}
 
 	void buildDelta1(std::vector<Util::SmartSet>& delta1) const {
 
-		delta1.resize(this->data_.size(), Util::SmartSet(this->states_));
+		delta1.resize(this->labels_, Util::SmartSet(this->states_));
 
-		for (size_t a = 0; a < this->data_.size(); ++a) {
+		for (size_t a = 0; a < this->labels_; ++a) {
 
-			for (size_t q = 0; q < this->data_[a].first.size(); ++q)
-				delta1[a].init(q, delta1[a].count(q) + this->data_[a].first[q].size());
+			for (size_t q = 0; q < this->states_; ++q)
+				delta1[a].init(q, delta1[a].count(q) + this->post(a, q).size());
 
 		}
 
 	}
 
-	size_t labels() const { return this->data_.size(); }
+	size_t labels() const { return this->labels_; }
 
 	const size_t& states() const { return this->states_; }
 
 	friend std::ostream& operator<<(std::ostream& os, const ExplicitLTS& lts) {
 
-		for (size_t a = 0; a < lts.data_.size(); ++a) {
+		for (size_t a = 0; a < lts.labels_; ++a) {
 
-			for (size_t q = 0; q < lts.data_[a].second.size(); ++q) {
+			for (size_t q = 0; q < lts.states_; ++q) {
 
-				for (auto& r : lts.data_[a].first[q])
+				for (auto& r : lts.post(a, q))
 					os << q << " --" << a << "--> " << r << std::endl;
 
 			}
@@ -143,13 +303,24 @@ public:
 
 public:
 
+	/**
+	 * @brief  Computes the simulation preorder
+	 *
+	 * @param[in]  partition   The initial partition of states
+	 * @param[in]  relation    The initial relation on the partition
+	 * @param[in]  outputSize  The number of states in the result
+	 * @param[in]  threadCnt   The number of threads (0 stands for the number of
+	 *                         hardware threads); the result does not depend on
+	 *                         it
+	 */
 	Util::BinaryRelation computeSimulation(
 		const std::vector<std::vector<size_t>>& partition,
 		const Util::BinaryRelation& relation,
-		size_t outputSize
+		size_t outputSize,
+		size_t threadCnt = 1
 	);
 
-	Util::BinaryRelation computeSimulation(size_t outputSize) {
+	Util::BinaryRelation computeSimulation(size_t outputSize, size_t threadCnt = 1) {
 
 		std::vector<std::vector<size_t>> partition(1);
 
@@ -157,7 +328,7 @@ public:
 			partition[0].push_back(i);
 
 		return this->computeSimulation(
-			partition, Util::BinaryRelation(1, true), outputSize
+			partition, Util::BinaryRelation(1, true), outputSize, threadCnt
 		);
 
 	}
@@ -29,11 +29,13 @@
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 
 namespace VATA
 {
 	class ExplicitTreeAut;
+	class Context;
 
 	template <
 		class>
@@ -373,6 +375,16 @@ public:   // methods
 
 	explicit ExplicitTreeAut(CoreAut&& core);
 
+	/**
+	 * @brief  Constructs an empty automaton bound to a context
+	 *
+	 * The automaton (and all automata derived from it) uses the tuple cache and
+	 * the alphabet of @p context, which needs to outlive the automaton.
+	 *
+	 * @param[in]  context  The context of the automaton
+	 */
+	explicit ExplicitTreeAut(Context& context);
+
 
 	static StringSymbolType ToStringSymbolType(const std::string& str, size_t rank)
 	{
@@ -465,6 +477,19 @@ public:   // methods
 		const StateType&          state);
 
 
+	/**
+	 * @brief  Compacts the transitions into a read-only layout
+	 *
+	 * After the call, read-only operations (e.g., ContainsTransition(),
+	 * Intersection(), RemoveUselessStates()) run on a contiguous copy of the
+	 * transition table. Any modification of the automaton drops the copy.
+	 */
+	void Freeze();
+
+
+	bool IsFrozen() const;
+
+
 	AlphabetType& GetAlphabet();
 
 
@@ -688,6 +713,69 @@ public:   // methods
 		AutBase::ProductTranslMap*        pTranslMap);
 
 
+	/**
+	 * @brief  Intersection of languages computed by several threads
+	 *
+	 * The same as Intersection(), but the product is explored by @p threadCnt
+	 * threads. The result is equal to the one of Intersection() up to renaming
+	 * of states.
+	 *
+	 * @param[in]   lhs             Left automaton
+	 * @param[in]   rhs             Right automaton
+	 * @param[out]  pTranslMap      Maps pairs of states to product states
+	 * @param[in]   threadCnt       The number of threads (0 for the number of
+	 *                              available cores)
+	 *
+	 * @returns  An automaton accepting the intersection of languages of @p lhs
+	 * and @p rhs
+	 */
+	static ExplicitTreeAut Intersection(
+		const ExplicitTreeAut&            lhs,
+		const ExplicitTreeAut&            rhs,
+		AutBase::ProductTranslMap*        pTranslMap,
+		size_t                            threadCnt);
+
+
+	/**
+	 * @brief  Checks emptiness of the intersection of languages
+	 *
+	 * Unlike computing Intersection() followed by RemoveUselessStates(), the
+	 * product is explored lazily (bottom-up) and the exploration stops as soon
+	 * as an accepting pair of states is reached.
+	 *
+	 * @param[in]   lhs       Left automaton
+	 * @param[in]   rhs       Right automaton
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, set to an automaton accepting a single tree
+	 *                        from the intersection
+	 *
+	 * @returns  @p true if the intersection of languages of @p lhs and @p rhs
+	 *           is empty, @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const ExplicitTreeAut&            lhs,
+		const ExplicitTreeAut&            rhs,
+		ExplicitTreeAut*                  pWitness = nullptr);
+
+
+	/**
+	 * @brief  Checks emptiness of the intersection of languages of automata
+	 *
+	 * The n-ary version of IsIntersectionEmpty().
+	 *
+	 * @param[in]   auts      The automata (at least one)
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, set to an automaton accepting a single tree
+	 *                        from the intersection
+	 *
+	 * @returns  @p true if the intersection of languages of @p auts is empty,
+	 *           @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const std::vector<const ExplicitTreeAut*>&   auts,
+		ExplicitTreeAut*                             pWitness = nullptr);
+
+
 	/**
 	 * @brief  Dispatcher for calling correct inclusion checking function
 	 *
@@ -159,11 +159,19 @@ namespace VATA
 		 */
 		const AutBase::StateBinaryRelation* simulation_;
 
+		/**
+		 * @brief  Number of threads used for the checking
+		 *
+		 * 0 denotes the number of hardware threads.
+		 */
+		size_t threadCnt_;
+
 	public:   // methods
 
 		InclParam() :
 			flags_(0),
-			simulation_(nullptr)
+			simulation_(nullptr),
+			threadCnt_(1)
 		{ }
 
 		void SetAlgorithm(e_algorithm alg)
@@ -324,6 +332,16 @@ namespace VATA
 			}
 		}
 
+		void SetThreadCount(size_t threadCnt)
+		{
+			threadCnt_ = threadCnt;
+		}
+
+		size_t GetThreadCount() const
+		{
+			return threadCnt_;
+		}
+
 		std::string toString() const;
 	};
 }
@@ -42,6 +42,13 @@ namespace VATA
 		 */
 		size_t numStates_ = static_cast<size_t>(-1);
 
+		/**
+		 * @brief  Number of threads used for the computation
+		 *
+		 * 0 denotes the number of hardware threads.
+		 */
+		size_t threadCnt_ = 1;
+
 	public:   // methods
 
 		void SetRelation(e_sim_relation rel)
@@ -64,6 +71,16 @@ namespace VATA
 			return numStates_;
 		}
 
+		void SetThreadCount(size_t threadCnt)
+		{
+			threadCnt_ = threadCnt;
+		}
+
+		size_t GetThreadCount() const
+		{
+			return threadCnt_;
+		}
+
 		std::string toString() const
 		{
 			std::string result = "SimParam relation: ";
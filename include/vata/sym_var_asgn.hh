@@ -16,6 +16,8 @@
 
 // Standard library headers
 #include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -56,10 +58,17 @@ private:  // Private data types
 	};
 
 
+	typedef uint64_t WordType;
+
 	enum
 	{
 		// needs to be multiple of BitsPerVariable
-		BitsInChar = 8
+		BitsInWord = 64
+	};
+
+	enum
+	{
+		VariablesInWord = BitsInWord / BitsPerVariable
 	};
 
 	enum
@@ -67,6 +76,11 @@ private:  // Private data types
 		DefaultMask = 0x03
 	};
 
+	/**
+	 * @brief  The lower bits of all variables in a word
+	 */
+	static const WordType LowBits = 0x5555555555555555ULL;
+
 
 private:  // Private data members
 
@@ -83,64 +97,110 @@ private:  // Private data members
 	/**
 	 * @brief  The value of the assignment
 	 *
-	 * Array of characters representing the value of the assignment.
+	 * Array of words representing the value of the assignment. Bits beyond
+	 * the last variable are always zero, so that assignments can be compared
+	 * word by word.
 	 */
-	std::vector<char> vars_;
+	std::vector<WordType> vars_;
 
 
 private:  // Private methods
 
-	static size_t numberOfChars(size_t varCount)
+	static size_t numberOfWords(size_t varCount)
 	{
-		if (varCount == 0)
-		{
-			return 0;
-		}
-		else
-		{
-			return (varCount * BitsPerVariable - 1) / BitsInChar + 1;
-		}
+		return (varCount + VariablesInWord - 1) / VariablesInWord;
 	}
 
 	/**
-	 * @brief  Gets index of @c char at given variable index
+	 * @brief  Gets index of the word at given variable index
 	 *
-	 * Returns index of the @c char that holds the value of variable at given
+	 * Returns index of the word that holds the value of variable at given
 	 * index.
 	 *
-	 * @see  getIndexInsideChar()
+	 * @see  getIndexInsideWord()
 	 *
 	 * @param[in]  index  Index of the Boolean variable
 	 *
-	 * @returns  Index of the @c char in which the variable has value
+	 * @returns  Index of the word in which the variable has value
 	 */
-	static size_t getIndexOfChar(size_t index)
+	static size_t getIndexOfWord(size_t index)
 	{
-		return (index * BitsPerVariable) / BitsInChar;
+		return index / VariablesInWord;
 	}
 
 
 	/**
-	 * @brief  Gets index of bit inside a @c char for given variable index
+	 * @brief  Gets index of bit inside a word for given variable index
 	 *
-	 * Returns index of a bit in a @c char that starts the block of bits that
+	 * Returns index of a bit in a word that starts the block of bits that
 	 * hold the value of variable at given index.
 	 *
-	 * @see  getIndexOfChar()
+	 * @see  getIndexOfWord()
 	 *
 	 * @param[in]  index  Index of the Boolean variable
 	 *
 	 * @returns  Index of the bit that holds the value of the variable
 	 */
-	static size_t getIndexInsideChar(size_t index)
+	static size_t getIndexInsideWord(size_t index)
+	{
+		return (index % VariablesInWord) * BitsPerVariable;
+	}
+
+	/**
+	 * @brief  Gets the bits of a word that belong to variables
+	 *
+	 * @param[in]  word  Index of the word
+	 *
+	 * @returns  Mask of the bits of the word used by the assignment
+	 */
+	WordType getUsedBits(size_t word) const
 	{
-		return (index * BitsPerVariable) % BitsInChar;
+		assert(word < vars_.size());
+
+		size_t rest = length() - word * VariablesInWord;
+		return (rest >= VariablesInWord)? ~WordType(0)
+			: ((WordType(1) << (rest * BitsPerVariable)) - 1);
 	}
 
-	static void getAllSymbols(
-		SymbolicVarAsgn&                  var,
-		std::vector<SymbolicVarAsgn>&     vec,
-		size_t                            pos);
+	/**
+	 * @brief  Gets the don't care variables of a word
+	 *
+	 * @param[in]  word  Index of the word
+	 *
+	 * @returns  Mask with the lower bit of every don't care variable set
+	 */
+	WordType getDontCareBits(size_t word) const
+	{
+		assert(word < vars_.size());
+
+		return vars_[word] & (vars_[word] >> 1) & LowBits;
+	}
+
+	/**
+	 * @brief  Spreads the lower half of a word to the lower bits of variables
+	 */
+	static WordType spreadBits(WordType bits)
+	{
+		bits &= 0x00000000FFFFFFFFULL;
+		bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFULL;
+		bits = (bits | (bits << 8))  & 0x00FF00FF00FF00FFULL;
+		bits = (bits | (bits << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+		bits = (bits | (bits << 2))  & 0x3333333333333333ULL;
+		bits = (bits | (bits << 1))  & LowBits;
+
+		return bits;
+	}
+
+	/**
+	 * @brief  Sets all variables to don't care
+	 */
+	void fillDontCare()
+	{
+		for (size_t i = 0; i < vars_.size(); ++i)
+		{
+			vars_[i] = getUsedBits(i);
+		}
+	}
 
 public:   // Public methods
 
@@ -156,21 +216,22 @@ public:   // Public methods
 
 	explicit SymbolicVarAsgn(size_t size) :
 		variablesCount_(size),
-		vars_(numberOfChars(size))
+		vars_(numberOfWords(size))
 	{
-		for (size_t i = 0; i < size; ++i)
-		{	// for each variable
-			SetIthVariableValue(i, DONT_CARE);
-		}
+		fillDontCare();
 	}
 
 	SymbolicVarAsgn(size_t size, size_t n) :
 		variablesCount_(size),
-		vars_(numberOfChars(size))
+		vars_(numberOfWords(size))
 	{
-		for (size_t i = 0; i < size; ++i)
-		{	// for each variable
-			SetIthVariableValue(i, ((n & (1 << i)) != 0)? ONE : ZERO);
+		for (size_t i = 0; i < vars_.size(); ++i)
+		{	// variable v gets the value of the v-th bit of n
+			WordType bits = (i * VariablesInWord < BitsInWord)?
+				(static_cast<WordType>(n) >> (i * VariablesInWord)) : 0;
+
+			vars_[i] = ((spreadBits(bits) << 1) | spreadBits(~bits)) &
+				getUsedBits(i);
 		}
 	}
 
@@ -214,7 +275,7 @@ public:   // Public methods
 		// Assertions
 		assert(i < length());
 
-		return (vars_[getIndexOfChar(i)] >> getIndexInsideChar(i)) & DefaultMask;
+		return (vars_[getIndexOfWord(i)] >> getIndexInsideWord(i)) & DefaultMask;
 	}
 
 
@@ -224,17 +285,13 @@ public:   // Public methods
 		assert(i < length());
 		assert((value == ZERO) || (value == ONE) || (value == DONT_CARE));
 
-		// prepare the mask
-		char mask = (DefaultMask << getIndexInsideChar(i)) ^ static_cast<char>(-1);
-
-		// mask out bits at given position by the mask
-		vars_[getIndexOfChar(i)] &= mask;
+		WordType& word = vars_[getIndexOfWord(i)];
 
-		// prepare new value of given bits
-		value <<= getIndexInsideChar(i);
+		// mask out bits at given position
+		word &= ~(static_cast<WordType>(DefaultMask) << getIndexInsideWord(i));
 
 		// insert the value of given bits
-		vars_[getIndexOfChar(i)] |= value;
+		word |= static_cast<WordType>(value) << getIndexInsideWord(i);
 	}
 
 	void AddVariablesUpTo(size_t maxVariableIndex);
@@ -296,7 +353,7 @@ public:   // Public methods
 		size_t offset = variablesCount_;
 		variablesCount_ += prefix.length();
 
-		vars_.resize(numberOfChars(variablesCount_));
+		vars_.resize(numberOfWords(variablesCount_));
 		for (size_t i = 0; i < prefix.length(); ++i)
 		{
 			SetIthVariableValue(offset + i, prefix.GetIthVariableValue(i));
@@ -304,6 +361,73 @@ public:   // Public methods
 	}
 
 
+	/**
+	 * @brief  Returns the number of don't care variables
+	 *
+	 * @returns  The number of variables with value DONT_CARE
+	 */
+	size_t GetDontCareCount() const
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < vars_.size(); ++i)
+		{
+			count += static_cast<size_t>(__builtin_popcountll(getDontCareBits(i)));
+		}
+
+		return count;
+	}
+
+
+	/**
+	 * @brief  Intersects two assignments
+	 *
+	 * Computes the assignment that matches exactly the concrete symbols
+	 * matched by both @p lhs and @p rhs, which need to be of the same length.
+	 *
+	 * @param[in]   lhs     The left-hand side assignment
+	 * @param[in]   rhs     The right-hand side assignment
+	 * @param[out]  result  The intersection (valid only if nonempty)
+	 *
+	 * @returns  @p true if the intersection is nonempty, @p false otherwise
+	 */
+	static bool Intersection(
+		const SymbolicVarAsgn&     lhs,
+		const SymbolicVarAsgn&     rhs,
+		SymbolicVarAsgn&           result)
+	{
+		// Assertions
+		assert(lhs.length() == rhs.length());
+
+		result.variablesCount_ = lhs.variablesCount_;
+		result.vars_.resize(lhs.vars_.size());
+		for (size_t i = 0; i < lhs.vars_.size(); ++i)
+		{	// a variable with both bits cleared has no value
+			WordType word = lhs.vars_[i] & rhs.vars_[i];
+			if (((word | (word >> 1)) & LowBits) != (lhs.getUsedBits(i) & LowBits))
+			{
+				return false;
+			}
+
+			result.vars_[i] = word;
+		}
+
+		return true;
+	}
+
+
+	class ConcreteSymbolIterator;
+
+	class ConcreteSymbolRange;
+
+
+	/**
+	 * @brief  Returns the concrete symbols lazily
+	 *
+	 * @returns  A range over the concrete symbols matched by the assignment
+	 */
+	ConcreteSymbolRange GetConcreteSymbols() const;
+
+
 	std::vector<SymbolicVarAsgn> GetVectorOfConcreteSymbols() const;
 
 
@@ -327,6 +451,23 @@ public:   // Public methods
 	}
 
 
+	friend bool operator==(
+		const SymbolicVarAsgn&     lhs,
+		const SymbolicVarAsgn&     rhs)
+	{
+		return (lhs.variablesCount_ == rhs.variablesCount_) &&
+			(lhs.vars_ == rhs.vars_);
+	}
+
+
+	friend bool operator!=(
+		const SymbolicVarAsgn&     lhs,
+		const SymbolicVarAsgn&     rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+
 	friend bool operator<(
 		const SymbolicVarAsgn&     lhs,
 		const SymbolicVarAsgn&     rhs)
@@ -336,45 +477,21 @@ public:   // Public methods
 			return lhs.length() < rhs.length();
 		}
 
-		for (size_t i = 0; i < lhs.length(); ++i)
-		{
-			char lhsIthValue = lhs.GetIthVariableValue(lhs.length() - i - 1);
-			char rhsIthValue = rhs.GetIthVariableValue(rhs.length() - i - 1);
-
-			switch (lhsIthValue)
+		for (size_t i = lhs.vars_.size(); i > 0; --i)
+		{	// the variable with the highest index decides
+			WordType diff = lhs.vars_[i - 1] ^ rhs.vars_[i - 1];
+			if (0 == diff)
 			{
-				case SymbolicVarAsgn::ZERO:
-					switch (rhsIthValue)
-					{
-						case SymbolicVarAsgn::ZERO:       continue;     break;
-						case SymbolicVarAsgn::ONE:        return true;  break;
-						case SymbolicVarAsgn::DONT_CARE:  return true;  break;
-						default: assert(false); break;   // fail gracefully
-					}
-					break;
-
-				case SymbolicVarAsgn::ONE:
-					switch (rhsIthValue)
-					{
-						case SymbolicVarAsgn::ZERO:       return false;  break;
-						case SymbolicVarAsgn::ONE:        continue;      break;
-						case SymbolicVarAsgn::DONT_CARE:  return false;  break;
-						default: assert(false); break;   // fail gracefully
-					}
-					break;
-
-				case SymbolicVarAsgn::DONT_CARE:
-					switch (rhsIthValue)
-					{
-						case SymbolicVarAsgn::ZERO:       return false;  break;
-						case SymbolicVarAsgn::ONE:        return true;   break;
-						case SymbolicVarAsgn::DONT_CARE:  continue;      break;
-						default: assert(false); break;   // fail gracefully
-					}
-					break;
-
-					default: assert(false); break;     // fail gracefully
+				continue;
 			}
+
+			size_t var = (i - 1) * VariablesInWord +
+				(BitsInWord - 1 - static_cast<size_t>(__builtin_clzll(diff))) /
+				BitsPerVariable;
+
+			// ZERO < DONT_CARE < ONE
+			return (lhs.GetIthVariableValue(var) == ZERO) ||
+				(rhs.GetIthVariableValue(var) == ONE);
 		}
 
 		return false;
@@ -389,4 +506,137 @@ public:   // Public static methods
 	}
 };
 
+
+/**
+ * @brief  Lazy iterator over concrete symbols
+ *
+ * Iterates over all concrete symbols matched by an assignment, in the
+ * order of GetVectorOfConcreteSymbols(), without materializing them.
+ */
+GCC_DIAG_OFF(effc++)
+class VATA::SymbolicVarAsgn::ConcreteSymbolIterator :
+	public std::iterator<std::input_iterator_tag, SymbolicVarAsgn>
+{
+GCC_DIAG_ON(effc++)
+
+private:  // Private data members
+
+	/// @brief  The current concrete symbol
+	SymbolicVarAsgn symbol_;
+
+	/// @brief  The don't care variables of the iterated assignment
+	std::vector<WordType> dontCares_;
+
+	/// @brief  Whether all symbols have been visited
+	bool end_;
+
+public:   // Public methods
+
+	ConcreteSymbolIterator() :
+		symbol_(),
+		dontCares_(),
+		end_(true)
+	{ }
+
+	explicit ConcreteSymbolIterator(const SymbolicVarAsgn& asgn) :
+		symbol_(asgn),
+		dontCares_(asgn.vars_.size()),
+		end_(false)
+	{
+		for (size_t i = 0; i < dontCares_.size(); ++i)
+		{	// start with all don't care variables set to ZERO
+			dontCares_[i] = asgn.getDontCareBits(i);
+			symbol_.vars_[i] &= ~(dontCares_[i] << 1);
+		}
+	}
+
+	ConcreteSymbolIterator& operator++()
+	{
+		assert(!end_);
+
+		for (size_t i = dontCares_.size(); i > 0; --i)
+		{	// the last don't care variable changes the fastest
+			WordType mask = dontCares_[i - 1];
+			WordType& word = symbol_.vars_[i - 1];
+			WordType ones = (word >> 1) & mask;
+			WordType zeros = mask & ~ones;
+
+			word &= ~(mask | (mask << 1));
+			if (0 == zeros)
+			{	// all are ONE, reset them and carry to previous words
+				word |= mask;
+				continue;
+			}
+
+			// the last ZERO becomes ONE and all following become ZERO
+			size_t bit = BitsInWord - 1 -
+				static_cast<size_t>(__builtin_clzll(zeros));
+			ones = (ones & ((WordType(1) << bit) - 1)) | (WordType(1) << bit);
+			word |= (mask & ~ones) | (ones << 1);
+			return *this;
+		}
+
+		end_ = true;
+		return *this;
+	}
+
+	const SymbolicVarAsgn& operator*() const
+	{
+		assert(!end_);
+
+		return symbol_;
+	}
+
+	const SymbolicVarAsgn* operator->() const
+	{
+		assert(!end_);
+
+		return &symbol_;
+	}
+
+	bool operator==(const ConcreteSymbolIterator& rhs) const
+	{
+		return (end_ == rhs.end_) && (end_ || (symbol_ == rhs.symbol_));
+	}
+
+	bool operator!=(const ConcreteSymbolIterator& rhs) const
+	{
+		return !(*this == rhs);
+	}
+};
+
+
+/**
+ * @brief  Range of concrete symbols of an assignment
+ */
+class VATA::SymbolicVarAsgn::ConcreteSymbolRange
+{
+private:  // Private data members
+
+	SymbolicVarAsgn asgn_;
+
+public:   // Public methods
+
+	explicit ConcreteSymbolRange(const SymbolicVarAsgn& asgn) :
+		asgn_(asgn)
+	{ }
+
+	ConcreteSymbolIterator begin() const
+	{
+		return ConcreteSymbolIterator(asgn_);
+	}
+
+	ConcreteSymbolIterator end() const
+	{
+		return ConcreteSymbolIterator();
+	}
+};
+
+
+inline VATA::SymbolicVarAsgn::ConcreteSymbolRange
+	VATA::SymbolicVarAsgn::GetConcreteSymbols() const
+{
+	return ConcreteSymbolRange(*this);
+}
+
 #endif
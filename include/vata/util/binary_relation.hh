@@ -16,8 +16,11 @@
 //#include <vata/util/convert.hh>
 
 // Standard library headers
-#include <vector>
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <vector>
 
 namespace VATA
 {
@@ -28,12 +31,73 @@ namespace VATA
 	}
 }
 
+/**
+ * @brief  A binary relation on a set of integers stored as a bit matrix
+ *
+ * Every row is stored in 64-bit words, so that operations on whole rows (such
+ * as intersection, union, inclusion tests or enumeration of related elements)
+ * process 64 pairs at once. The matrix has a capacity (the row size) which is
+ * always a power of two and grows by doubling.
+ */
 class VATA::Util::BinaryRelation
 {
-	std::vector<bool> data_;
+public:   // data types
+
+	typedef uint64_t Word;
+
+	static const size_t WordBits = 64;
+
+private:  // data members
+
+	std::vector<Word> data_;
 	size_t rowSize_;
+	size_t rowWords_;
 	size_t size_;
 
+private:  // methods
+
+	static size_t wordCount(size_t bits)
+	{
+		return (bits + WordBits - 1) / WordBits;
+	}
+
+	static Word fill(bool defVal)
+	{
+		return (defVal)? ~Word(0) : Word(0);
+	}
+
+	// mask of valid bits in the last word of a row
+	Word lastMask() const
+	{
+		return (size_ % WordBits)? ((Word(1) << (size_ % WordBits)) - 1) : ~Word(0);
+	}
+
+	Word* row(size_t r)
+	{
+		return data_.data() + r*rowWords_;
+	}
+
+	const Word* row(size_t r) const
+	{
+		return data_.data() + r*rowWords_;
+	}
+
+	// transposes a 64x64 bit matrix (bit c of a[r] is the entry (r, c))
+	static void transpose64(Word* a)
+	{
+		Word m = 0x00000000FFFFFFFFULL;
+
+		for (size_t j = 32; j != 0; j >>= 1, m ^= (m << j))
+		{
+			for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j)
+			{
+				Word t = ((a[k] >> j) ^ a[k | j]) & m;
+				a[k] ^= (t << j);
+				a[k | j] ^= t;
+			}
+		}
+	}
+
 protected:
 
 	void realloc(size_t newRowSize, bool defVal)
@@ -41,16 +105,27 @@ protected:
 		// check for sane parameters
 		assert(0 < newRowSize);
 
-		std::vector<bool> tmp(newRowSize*newRowSize, defVal);
-		std::vector<bool>::const_iterator src = data_.begin();
-		std::vector<bool>::iterator dst = tmp.begin();
-		for (size_t i = 0; i < size_; ++i) {
-			std::copy(src, src + size_, dst);
-			src += rowSize_;
-			dst += newRowSize;
+		size_t newRowWords = wordCount(newRowSize);
+		std::vector<Word> tmp(newRowSize*newRowWords, fill(defVal));
+
+		// the bits behind size_ get the default value
+		size_t fullWords = size_ / WordBits;
+		Word mask = lastMask();
+		for (size_t i = 0; i < size_; ++i)
+		{
+			const Word* src = this->row(i);
+			Word* dst = tmp.data() + i*newRowWords;
+
+			std::copy(src, src + fullWords, dst);
+			if (size_ % WordBits)
+			{
+				dst[fullWords] = (src[fullWords] & mask) | (fill(defVal) & ~mask);
+			}
 		}
+
 		std::swap(data_, tmp);
 		rowSize_ = newRowSize;
+		rowWords_ = newRowWords;
 	}
 
 	void grow(size_t newSize, bool defVal = false)
@@ -64,23 +139,12 @@ protected:
 		this->realloc(newRowSize, defVal);
 
 	}
-/*
-	void shrinkToFit() {
 
-		assert(this->rowSize_ > this->size_);
-		size_t newRowSize = this->rowSize_;
-		while (this->size_ < (newRowSize >> 1))
-			newRowSize >>= 1;
-		assert(this->size_ <= newRowSize);
-		this->realloc(newRowSize);
-
-	}
-*/
 public:
 
 	void reset(bool defVal)
 	{
-		std::fill(data_.begin(), data_.end(), defVal);
+		std::fill(data_.begin(), data_.end(), fill(defVal));
 	}
 
 	void resize(size_t size, bool defVal = false)
@@ -113,44 +177,46 @@ public:
 			this->grow(size_ + 1);
 		}
 
-		assert((size_ + 1)*rowSize_ <= data_.size());
+		assert((size_ + 1)*rowWords_ <= data_.size());
 
-		// fill collumns
-		auto src = data_.begin() + i;
-		auto end = src + size_*rowSize_;
-		auto dst = data_.begin() + size_;
+		size_t n = size_++;
 
-		for ( ; src != end; src += rowSize_, dst += rowSize_)
+		// fill collumns
+		for (size_t r = 0; r < n; ++r)
 		{
-			*dst = *src;
+			this->set(r, n, this->get(r, i));
 		}
 
-		// fill rows
-		src = data_.begin() + i*rowSize_;
-		dst = data_.begin() + size_*rowSize_;
-
-		std::copy(src, src + size_, dst);
+		// fill rows (only the first n bits, like the columns)
+		const Word* src = this->row(i);
+		Word* dst = this->row(n);
+		std::copy(src, src + n / WordBits, dst);
+		if (n % WordBits)
+		{
+			Word mask = (Word(1) << (n % WordBits)) - 1;
+			dst[n / WordBits] = (src[n / WordBits] & mask) | (dst[n / WordBits] & ~mask);
+		}
 
 		// set the reflexive bit
-		*(dst + size_) = reflexive;
+		this->set(n, n, reflexive);
 
-		return size_++;
+		return n;
 	}
 
 	bool get(size_t r, size_t c) const
 	{
 		assert(r < size_ && c < size_);
-		assert(r*rowSize_ + c < data_.size());
 
-		return data_[r*rowSize_ + c];
+		return (this->row(r)[c / WordBits] >> (c % WordBits)) & 1;
 	}
 
 	void set(size_t r, size_t c, bool v)
 	{
 		assert(r < size_ && c < size_);
-		assert(r*rowSize_ + c < data_.size());
 
-		data_[r*rowSize_ + c] = v;
+		Word& w = this->row(r)[c / WordBits];
+		Word bit = Word(1) << (c % WordBits);
+		w = (v)? (w | bit) : (w & ~bit);
 	}
 
 	size_t size() const
@@ -158,6 +224,154 @@ public:
 		return size_;
 	}
 
+	/**
+	 * @brief  Calls @p f with every @p c such that (@p r, @p c) is in the
+	 *         relation, in ascending order
+	 */
+	template <class F>
+	void forEachInRow(size_t r, F f) const
+	{
+		assert(r < size_);
+
+		const Word* src = this->row(r);
+		size_t words = wordCount(size_);
+
+		for (size_t i = 0; i < words; ++i)
+		{
+			Word w = (i + 1 == words)? (src[i] & this->lastMask()) : src[i];
+
+			while (w)
+			{
+				f(i*WordBits + static_cast<size_t>(__builtin_ctzll(w)));
+				w &= w - 1;
+			}
+		}
+	}
+
+	/**
+	 * @brief  The number of elements related to @p r
+	 */
+	size_t rowCount(size_t r) const
+	{
+		assert(r < size_);
+
+		const Word* src = this->row(r);
+		size_t words = wordCount(size_);
+		size_t count = 0;
+
+		for (size_t i = 0; i < words; ++i)
+		{
+			Word w = (i + 1 == words)? (src[i] & this->lastMask()) : src[i];
+			count += static_cast<size_t>(__builtin_popcountll(w));
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief  The number of pairs in the relation
+	 */
+	size_t count() const
+	{
+		size_t count = 0;
+		for (size_t r = 0; r < size_; ++r)
+		{
+			count += this->rowCount(r);
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief  Checks whether the row @p lhs is a subset of the row @p rhs
+	 */
+	bool isRowSubset(size_t lhs, size_t rhs) const
+	{
+		assert(lhs < size_ && rhs < size_);
+
+		const Word* l = this->row(lhs);
+		const Word* r = this->row(rhs);
+		size_t words = wordCount(size_);
+
+		for (size_t i = 0; i < words; ++i)
+		{
+			Word w = l[i] & ~r[i];
+			if ((i + 1 == words)? (w & this->lastMask()) : w)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief  Adds the row @p src to the row @p dst
+	 */
+	void rowOr(size_t dst, size_t src)
+	{
+		assert(dst < size_ && src < size_);
+
+		Word* d = this->row(dst);
+		const Word* s = this->row(src);
+		size_t words = wordCount(size_);
+
+		for (size_t i = 0; i + 1 < words; ++i)
+		{
+			d[i] |= s[i];
+		}
+
+		if (words)
+		{
+			d[words - 1] |= s[words - 1] & this->lastMask();
+		}
+	}
+
+	/**
+	 * @brief  Intersects the row @p dst with the row @p src
+	 */
+	void rowAnd(size_t dst, size_t src)
+	{
+		assert(dst < size_ && src < size_);
+
+		Word* d = this->row(dst);
+		const Word* s = this->row(src);
+		size_t words = wordCount(size_);
+
+		for (size_t i = 0; i + 1 < words; ++i)
+		{
+			d[i] &= s[i];
+		}
+
+		if (words)
+		{
+			d[words - 1] &= s[words - 1] | ~this->lastMask();
+		}
+	}
+
+	/**
+	 * @brief  Replaces the relation by its reflexive and transitive closure
+	 */
+	void closure()
+	{
+		for (size_t r = 0; r < size_; ++r)
+		{
+			this->set(r, r, true);
+		}
+
+		// Warshall's algorithm on whole rows
+		for (size_t k = 0; k < size_; ++k)
+		{
+			for (size_t r = 0; r < size_; ++r)
+			{
+				if ((r != k) && this->get(r, k))
+				{
+					this->rowOr(r, k);
+				}
+			}
+		}
+	}
+
 public:
 
 	typedef std::vector<std::vector<size_t>> IndexType;
@@ -166,21 +380,18 @@ public:
 		size_t         size = 0,
 		bool           defVal = false,
 		size_t         rowSize = 16) :
-		data_(rowSize*rowSize, defVal),
+		data_(rowSize*wordCount(rowSize), fill(defVal)),
 		rowSize_(rowSize),
+		rowWords_(wordCount(rowSize)),
 		size_(0)
 	{
 		this->resize(size, defVal);
 	}
 
-/*
-	BinaryRelation(const BinaryRelation& rel)
-		: data_(rel.data_), rowSize_(rel.rowSize_), size_(rel.size_) {}
-*/
-
 	BinaryRelation(const std::vector<std::vector<bool> >& rel) :
-		data_(16*16, false),
+		data_(16*wordCount(16), 0),
 		rowSize_(16),
+		rowWords_(wordCount(16)),
 		size_(0)
 	{
 		this->resize(rel.size(), false);
@@ -194,8 +405,10 @@ public:
 		}
 	}
 
-	// TODO: does this do what is expected? What is expected this should do???
-	// WHAT ABOUT SOME FREAKING DOCUMENTATION??????
+	/**
+	 * @brief  Checks whether both (@p r, @p c) and (@p c, @p r) are in the
+	 *         relation
+	 */
 	bool sym(size_t r, size_t c) const
 	{
 		return this->get(r, c) && this->get(c, r);
@@ -204,25 +417,14 @@ public:
 	// build equivalence classes
 	void buildClasses(std::vector<size_t>& headIndex) const
 	{
-		headIndex.resize(size_);
+		std::vector<size_t> index;
 		std::vector<size_t> head;
+		this->buildClasses(index, head);
+
+		headIndex.resize(size_);
 		for (size_t i = 0; i < size_; ++i)
 		{
-			size_t j = 0;
-			while ((j < head.size()) && !this->sym(i, head[j]))
-			{
-				++j;
-			}
-
-			if (j < head.size())
-			{
-				headIndex[i] = head[j];
-			}
-			else
-			{
-				headIndex[i] = i;
-				head.push_back(i);
-			}
+			headIndex[i] = head[index[i]];
 		}
 	}
 
@@ -234,21 +436,39 @@ public:
 		index.resize(size_);
 		head.clear();
 
+		// every element belongs to the class of the first head symmetric with it;
+		// the candidates are found using word operations on the mask of heads
+		std::vector<Word> headMask(wordCount(size_), 0);
+		std::vector<size_t> headNumber(size_);
+
 		for (size_t i = 0; i < size_; ++i)
 		{
-			size_t j = 0;
-			while ((j < head.size()) && !this->sym(i, head[j]))
-			{
-				++j;
-			}
+			const Word* src = this->row(i);
+			bool found = false;
 
-			if (j < head.size())
+			for (size_t w = 0; !found && (w <= i / WordBits); ++w)
 			{
-				index[i] = j;
+				Word cand = src[w] & headMask[w];
+
+				while (cand)
+				{
+					size_t h = w*WordBits + static_cast<size_t>(__builtin_ctzll(cand));
+					cand &= cand - 1;
+
+					if (this->get(h, i))
+					{
+						index[i] = headNumber[h];
+						found = true;
+						break;
+					}
+				}
 			}
-			else
+
+			if (!found)
 			{
 				index[i] = head.size();
+				headNumber[i] = head.size();
+				headMask[i / WordBits] |= Word(1) << (i % WordBits);
 				head.push_back(i);
 			}
 		}
@@ -259,55 +479,98 @@ public:
 	{
 		assert(size_ == rhs.size_);
 
+		size_t words = wordCount(size_);
+		Word mask = this->lastMask();
+
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
+			Word* d = this->row(i);
+			const Word* s = rhs.row(i);
+
+			for (size_t j = 0; j + 1 < words; ++j)
 			{
-				this->set(i, j, this->get(i, j) && rhs.get(i,j));
+				d[j] &= s[j];
 			}
+
+			d[words - 1] &= s[words - 1] | ~mask;
 		}
 
 		return *this;
 	}
 
-	// transposition
-	BinaryRelation& transposed(BinaryRelation& dst) const
+	// or composition
+	BinaryRelation& operator|=(const BinaryRelation& rhs)
 	{
-		dst.resize(size_);
+		assert(size_ == rhs.size_);
+
+		size_t words = wordCount(size_);
+		Word mask = this->lastMask();
+
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
+			Word* d = this->row(i);
+			const Word* s = rhs.row(i);
+
+			for (size_t j = 0; j + 1 < words; ++j)
 			{
-				dst.set(j, i, this->get(i, j));
+				d[j] |= s[j];
 			}
+
+			d[words - 1] |= s[words - 1] & mask;
 		}
 
-		return dst;
+		return *this;
 	}
 
-	// relation index
-	void buildIndex(IndexType& dst) const
+	// transposition
+	BinaryRelation& transposed(BinaryRelation& dst) const
 	{
+		assert(&dst != this);
+
 		dst.resize(size_);
 
-		auto rowStart = data_.begin();
-		auto src = rowStart;
-		auto end = src + size_*rowSize_;
-		auto dstIter = dst.begin();
+		size_t words = wordCount(size_);
+		Word block[WordBits];
 
-		for (; src != end; src = rowStart, ++dstIter)
+		// the matrix is transposed by blocks of 64x64 bits
+		for (size_t bi = 0; bi < words; ++bi)
 		{
-			auto rowEnd = src + size_;
-			rowStart = src + rowSize_;
+			size_t rows = std::min<size_t>(size_ - bi*WordBits, +WordBits);
 
-			for (size_t i = 0; src != rowEnd; ++src, ++i)
+			for (size_t bj = 0; bj < words; ++bj)
 			{
-				if (*src)
+				Word mask = (bj + 1 == words)? this->lastMask() : ~Word(0);
+
+				for (size_t k = 0; k < WordBits; ++k)
 				{
-					dstIter->push_back(i);
+					block[k] = (k < rows)? (this->row(bi*WordBits + k)[bj] & mask) : 0;
+				}
+
+				transpose64(block);
+
+				size_t cols = std::min<size_t>(size_ - bj*WordBits, +WordBits);
+				Word colMask = (WordBits == rows)? ~Word(0) : ((Word(1) << rows) - 1);
+
+				for (size_t k = 0; k < cols; ++k)
+				{
+					Word& w = dst.row(bj*WordBits + k)[bi];
+					w = (w & ~colMask) | block[k];
 				}
 			}
 		}
+
+		return dst;
+	}
+
+	// relation index
+	void buildIndex(IndexType& dst) const
+	{
+		dst.resize(size_);
+
+		for (size_t i = 0; i < size_; ++i)
+		{
+			this->forEachInRow(i, [&dst, i](size_t j){ dst[i].push_back(j); });
+		}
 	}
 
 	// inverted relation index
@@ -317,13 +580,7 @@ public:
 
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				if (this->get(i, j))
-				{
-					dst[j].push_back(i);
-				}
-			}
+			this->forEachInRow(i, [&dst, i](size_t j){ dst[j].push_back(i); });
 		}
 	}
 
@@ -335,14 +592,11 @@ public:
 
 		for (size_t i = 0; i < size_; ++i)
 		{
-			for (size_t j = 0; j < size_; ++j)
-			{
-				if (this->get(i, j))
+			this->forEachInRow(i, [&ind, &inv, i](size_t j)
 				{
 					ind[i].push_back(j);
 					inv[j].push_back(i);
-				}
-			}
+				});
 		}
 	}
 
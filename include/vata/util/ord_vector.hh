@@ -143,6 +143,13 @@ public:   // Public methods
 		assert(vectorIsSorted());
 	}
 
+	OrdVector(const OrdVector& rhs) :
+		vec_(rhs.vec_)
+	{
+		// Assertions
+		assert(vectorIsSorted());
+	}
+
 	OrdVector& operator=(const OrdVector& rhs)
 	{
 		// Assertions
@@ -0,0 +1,458 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Vector with inline storage for a small number of elements.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_SMALL_VECTOR_HH_
+#define _VATA_SMALL_VECTOR_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Boost library headers
+#include <boost/functional/hash.hpp>
+
+
+namespace VATA
+{
+	namespace Util
+	{
+		template <
+			class T,
+			size_t N>
+		class SmallVector;
+	}
+}
+
+
+/**
+ * @brief  A vector with inline storage for small sizes
+ *
+ * The class provides (a subset of) the interface of std::vector. Up to @p N
+ * elements are stored inside the object itself, so that short sequences (such
+ * as tuples of states of transitions of small rank) do not touch the heap at
+ * all. Longer sequences are stored in a heap buffer, like in std::vector.
+ *
+ * Only trivially copyable types are supported, which allows to move the
+ * elements around using plain memory copies.
+ *
+ * The class converts implicitly from and to std::vector, so that code written
+ * for tuples of states stored in std::vector keeps compiling.
+ */
+template <
+	class T,
+	size_t N>
+class VATA::Util::SmallVector
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+		"SmallVector supports only trivially copyable types");
+
+	static_assert(N > 0, "SmallVector needs a nonzero inline capacity");
+
+public:   // data types
+
+	using value_type       = T;
+	using size_type        = size_t;
+	using difference_type  = std::ptrdiff_t;
+	using reference        = T&;
+	using const_reference  = const T&;
+	using pointer          = T*;
+	using const_pointer    = const T*;
+	using iterator         = T*;
+	using const_iterator   = const T*;
+	using reverse_iterator        = std::reverse_iterator<iterator>;
+	using const_reverse_iterator  = std::reverse_iterator<const_iterator>;
+
+private:  // data members
+
+	T* data_;
+	uint32_t size_;
+	uint32_t capacity_;
+	T inline_[N];
+
+private:  // methods
+
+	bool isInline() const
+	{
+		return data_ == inline_;
+	}
+
+	void grow(size_t minCapacity)
+	{
+		size_t newCapacity = std::max(minCapacity, 2 * static_cast<size_t>(capacity_));
+		assert(newCapacity <= UINT32_MAX);
+
+		T* newData = static_cast<T*>(std::malloc(newCapacity * sizeof(T)));
+		if (nullptr == newData)
+		{
+			throw std::bad_alloc();
+		}
+
+		std::memcpy(newData, data_, size_ * sizeof(T));
+
+		if (!isInline())
+		{
+			std::free(data_);
+		}
+
+		data_ = newData;
+		capacity_ = static_cast<uint32_t>(newCapacity);
+	}
+
+	void steal(SmallVector& other)
+	{
+		assert(isInline());
+
+		if (other.isInline())
+		{
+			std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+			size_ = other.size_;
+		}
+		else
+		{
+			data_ = other.data_;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+
+			other.data_ = other.inline_;
+			other.capacity_ = N;
+		}
+
+		other.size_ = 0;
+	}
+
+public:   // methods
+
+	SmallVector() :
+		data_(inline_),
+		size_(0),
+		capacity_(N),
+		inline_()
+	{ }
+
+	explicit SmallVector(size_t count, const T& value = T()) :
+		SmallVector()
+	{
+		this->resize(count, value);
+	}
+
+	template <
+		class InputIterator,
+		class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+	SmallVector(InputIterator first, InputIterator last) :
+		SmallVector()
+	{
+		for (; first != last; ++first)
+		{
+			this->push_back(*first);
+		}
+	}
+
+	SmallVector(std::initializer_list<T> init) :
+		SmallVector(init.begin(), init.end())
+	{ }
+
+	template <class Allocator>
+	SmallVector(const std::vector<T, Allocator>& vec) :
+		SmallVector(vec.begin(), vec.end())
+	{ }
+
+	SmallVector(const SmallVector& other) :
+		SmallVector(other.begin(), other.end())
+	{ }
+
+	SmallVector(SmallVector&& other) :
+		SmallVector()
+	{
+		this->steal(other);
+	}
+
+	~SmallVector()
+	{
+		if (!isInline())
+		{
+			std::free(data_);
+		}
+	}
+
+	SmallVector& operator=(const SmallVector& rhs)
+	{
+		if (this != &rhs)
+		{
+			this->assign(rhs.begin(), rhs.end());
+		}
+
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& rhs)
+	{
+		if (this != &rhs)
+		{
+			if (!isInline())
+			{
+				std::free(data_);
+				data_ = inline_;
+				capacity_ = N;
+			}
+
+			this->steal(rhs);
+		}
+
+		return *this;
+	}
+
+	operator std::vector<T>() const
+	{
+		return std::vector<T>(begin(), end());
+	}
+
+	template <class InputIterator>
+	void assign(InputIterator first, InputIterator last)
+	{
+		SmallVector tmp(first, last);
+		*this = std::move(tmp);
+	}
+
+	iterator begin()                       { return data_; }
+	const_iterator begin() const           { return data_; }
+	const_iterator cbegin() const          { return data_; }
+	iterator end()                         { return data_ + size_; }
+	const_iterator end() const             { return data_ + size_; }
+	const_iterator cend() const            { return data_ + size_; }
+
+	reverse_iterator rbegin()              { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const  { return const_reverse_iterator(end()); }
+	reverse_iterator rend()                { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const    { return const_reverse_iterator(begin()); }
+
+	size_t size() const       { return size_; }
+	size_t capacity() const   { return capacity_; }
+	bool empty() const        { return 0 == size_; }
+
+	T* data()                 { return data_; }
+	const T* data() const     { return data_; }
+
+	T& operator[](size_t i)
+	{
+		assert(i < size_);
+		return data_[i];
+	}
+
+	const T& operator[](size_t i) const
+	{
+		assert(i < size_);
+		return data_[i];
+	}
+
+	T& at(size_t i)
+	{
+		if (i >= size_)
+		{
+			throw std::out_of_range("SmallVector::at()");
+		}
+
+		return data_[i];
+	}
+
+	const T& at(size_t i) const
+	{
+		if (i >= size_)
+		{
+			throw std::out_of_range("SmallVector::at()");
+		}
+
+		return data_[i];
+	}
+
+	T& front()                { assert(!empty()); return data_[0]; }
+	const T& front() const    { assert(!empty()); return data_[0]; }
+	T& back()                 { assert(!empty()); return data_[size_ - 1]; }
+	const T& back() const     { assert(!empty()); return data_[size_ - 1]; }
+
+	void reserve(size_t newCapacity)
+	{
+		if (newCapacity > capacity_)
+		{
+			this->grow(newCapacity);
+		}
+	}
+
+	void resize(size_t count, const T& value = T())
+	{
+		this->reserve(count);
+
+		for (size_t i = size_; i < count; ++i)
+		{
+			data_[i] = value;
+		}
+
+		size_ = static_cast<uint32_t>(count);
+	}
+
+	void clear()
+	{
+		size_ = 0;
+	}
+
+	void push_back(const T& value)
+	{
+		if (size_ == capacity_)
+		{
+			// the value may refer into the buffer
+			T copy = value;
+			this->grow(size_ + 1);
+			data_[size_++] = copy;
+		}
+		else
+		{
+			data_[size_++] = value;
+		}
+	}
+
+	template <class... Args>
+	void emplace_back(Args&&... args)
+	{
+		this->push_back(T(std::forward<Args>(args)...));
+	}
+
+	void pop_back()
+	{
+		assert(!empty());
+		--size_;
+	}
+
+	iterator insert(const_iterator pos, const T& value)
+	{
+		return this->insert(pos, &value, &value + 1);
+	}
+
+	template <
+		class InputIterator,
+		class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+	iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+	{
+		assert((begin() <= pos) && (pos <= end()));
+
+		size_t offset = pos - begin();
+
+		// the input is copied first, it may refer into the buffer
+		SmallVector tmp;
+		for (; first != last; ++first)
+		{
+			tmp.push_back(*first);
+		}
+
+		if (tmp.empty())
+		{
+			return begin() + offset;
+		}
+
+		this->reserve(size_ + tmp.size());
+
+		std::memmove(data_ + offset + tmp.size(), data_ + offset,
+			(size_ - offset) * sizeof(T));
+		std::memcpy(data_ + offset, tmp.data_, tmp.size() * sizeof(T));
+		size_ += static_cast<uint32_t>(tmp.size());
+
+		return begin() + offset;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		return this->erase(pos, pos + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		assert((begin() <= first) && (first <= last) && (last <= end()));
+
+		size_t offset = first - begin();
+		size_t count = last - first;
+
+		std::memmove(data_ + offset, data_ + offset + count,
+			(size_ - offset - count) * sizeof(T));
+		size_ -= static_cast<uint32_t>(count);
+
+		return begin() + offset;
+	}
+
+	void swap(SmallVector& other)
+	{
+		SmallVector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	bool operator==(const SmallVector& rhs) const
+	{
+		return (size_ == rhs.size_) && std::equal(begin(), end(), rhs.begin());
+	}
+
+	bool operator!=(const SmallVector& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	bool operator<(const SmallVector& rhs) const
+	{
+		return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+	}
+
+	bool operator>(const SmallVector& rhs) const
+	{
+		return rhs < *this;
+	}
+
+	bool operator<=(const SmallVector& rhs) const
+	{
+		return !(rhs < *this);
+	}
+
+	bool operator>=(const SmallVector& rhs) const
+	{
+		return !(*this < rhs);
+	}
+
+	friend size_t hash_value(const SmallVector& vec)
+	{
+		return boost::hash_range(vec.begin(), vec.end());
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const SmallVector& vec)
+	{
+		os << "(";
+		for (auto it = vec.begin(); it != vec.end(); ++it)
+		{
+			if (it != vec.begin())
+			{
+				os << ", ";
+			}
+
+			os << *it;
+		}
+
+		return os << ")";
+	}
+};
+
+#endif
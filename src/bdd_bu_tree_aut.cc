@@ -300,6 +300,24 @@ BDDTopDownTreeAut BDDBottomUpTreeAut::GetTopDownAut() const
 }
 
 
+BDDBottomUpTreeAut BDDBottomUpTreeAut::FromExplicit(
+	const ExplicitTreeAut&            aut,
+	const ExplicitSymbolEncoding&     encoding)
+{
+	return BDDBottomUpTreeAut(
+		CoreAut(BDDBUTreeAutCore::FromExplicit(aut, encoding)));
+}
+
+
+VATA::ExplicitTreeAut BDDBottomUpTreeAut::ToExplicit(
+	const ExplicitSymbolEncoding&     encoding) const
+{
+	assert(nullptr != core_);
+
+	return core_->ToExplicit(encoding);
+}
+
+
 BDDBottomUpTreeAut BDDBottomUpTreeAut::GetCandidateTree() const
 {
 	throw NotImplementedException(__func__);
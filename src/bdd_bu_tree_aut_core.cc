@@ -71,6 +71,25 @@ void BDDBUTreeAutCore::AddTransition(
 }
 
 
+void BDDBUTreeAutCore::AddTransitions(
+	const StateTuple&                     children,
+	const TransMTBDD::AsgnValueList&      symbolParentsList)
+{
+	if (transTable_.unique())
+	{
+		UnionApplyFunctor unioner;
+
+		TransMTBDD addedMtbdd = TransMTBDD::Build(symbolParentsList, StateSet(),
+			[](const StateSet& lhs, const StateSet& rhs){ return lhs.Union(rhs); });
+		this->SetMtbdd(children, unioner(this->GetMtbdd(children), addedMtbdd));
+	}
+	else
+	{	// copy on write
+		assert(false);
+	}
+}
+
+
 BDDBUTreeAutCore::TransMTBDD BDDBUTreeAutCore::ReindexStates(
 	BDDBUTreeAutCore&          dstAut,
 	StateToStateTranslWeak&    stateTransl) const
@@ -93,7 +112,7 @@ BDDBUTreeAutCore::TransMTBDD BDDBUTreeAutCore::ReindexStates(
 
 		StateSet ApplyOperation(const StateSet& value)
 		{
-			StateSet result;
+			StateSet::SetType result;
 
 			for (const StateType& state : value)
 			{ // for every state
@@ -142,10 +161,12 @@ BDDBUTreeAutCore BDDBUTreeAutCore::ReindexStates(
 
 BDDTDTreeAutCore BDDBUTreeAutCore::GetTopDownAut() const
 {
+	using TDStateTupleSet = BDDTDTreeAutCore::StateTupleSet;
+
 	GCC_DIAG_OFF(effc++)    // suppress missing virtual destructor warning
 	class InverterApplyFunctor :
 		public VATA::MTBDDPkg::Apply2Functor<InverterApplyFunctor, StateSet,
-		StateTupleSet, StateTupleSet>
+		TDStateTupleSet, TDStateTupleSet>
 	{
 	GCC_DIAG_OFF(effc++)    // suppress missing virtual destructor warning
 	private:  // data members
@@ -162,14 +183,14 @@ BDDTDTreeAutCore BDDBUTreeAutCore::GetTopDownAut() const
 			checkedTuple_(checkedTuple)
 		{ }
 
-		inline StateTupleSet ApplyOperation(
+		inline TDStateTupleSet ApplyOperation(
 			const StateSet&         lhs,
-			const StateTupleSet&    rhs)
+			const TDStateTupleSet&  rhs)
 		{
-			StateTupleSet result = rhs;
+			TDStateTupleSet result = rhs;
 			if (lhs.find(soughtState_) != lhs.end())
 			{
-				result.insert(checkedTuple_);
+				result = result.Union(TDStateTupleSet(checkedTuple_));
 			}
 
 			return result;
@@ -23,6 +23,7 @@
 
 #include "symbolic_tree_aut_base_core.hh"
 #include "util/bdd_bu_trans_table.hh"
+#include "util/interned_set.hh"
 #include "bdd_bu_tt_wrapper.hh"
 
 
@@ -33,13 +34,14 @@ GCC_DIAG_ON(effc++)
 
 public:   // data types
 
-	using StateSet        = VATA::Util::OrdVector<StateType>;
+	using StateSet        = Util::InternedSet<StateType>;
 	using StateTupleSet   = Util::OrdVector<StateTuple>;
 	using StateHT         = std::unordered_set<StateType>;
 
 	using MTBDDHandle     = size_t;
 	using TransTable      = Util::TransTableWrapper<MTBDDHandle, StateSet>;
 	using TransMTBDD      = TransTable::TransMTBDD;
+	using TupleId         = TransTable::TupleId;
 
 private:  // data types
 
@@ -51,6 +53,10 @@ private:  // data types
 		StateSet, StateSet>
 	{
 	GCC_DIAG_ON(effc++)
+	public:   // constants
+
+		static const bool SHARED_CACHE = true;
+
 	public:   // methods
 
 		StateSet ApplyOperation(const StateSet& lhs, const StateSet& rhs)
@@ -208,6 +214,10 @@ private:  // methods
 			finalStates_.insert(stateTransl(fst));
 		}
 
+		// transitions grouped by tuples (in the order of their first occurrence)
+		std::vector<std::pair<StateTuple, TransMTBDD::AsgnValueList>> tupleList;
+		std::unordered_map<StateTuple, size_t, boost::hash<StateTuple>> tupleIndex;
+
 		for (const AutDescription::Transition& trans : desc.transitions)
 		{	// traverse the transitions
 			const AutDescription::StateTuple& childrenStr = trans.first;
@@ -227,7 +237,21 @@ private:  // methods
 			// translate the symbol
 			SymbolType symbol = symbolTransl(symbolStr);
 
-			this->AddTransition(children, symbol, parent);
+			auto itIndex = tupleIndex.insert(
+				std::make_pair(children, tupleList.size())).first;
+			if (tupleList.size() == itIndex->second)
+			{	// in case the tuple is new
+				tupleList.push_back(
+					std::make_pair(children, TransMTBDD::AsgnValueList()));
+			}
+
+			tupleList[itIndex->second].second.push_back(
+				std::make_pair(symbol, StateSet(parent)));
+		}
+
+		for (const auto& tupleTransPair : tupleList)
+		{	// build the MTBDDs
+			this->AddTransitions(tupleTransPair.first, tupleTransPair.second);
 		}
 	}
 
@@ -288,6 +312,19 @@ public:   // methods
 		transTable_.SetMtbdd(children, mtbdd);
 	}
 
+	/**
+	 * @brief  Calls @p func on every tuple containing @p state
+	 *
+	 * @see  TransTableWrapper::ForeachTupleWithChildDo()
+	 */
+	template <class Func>
+	void ForeachTupleWithChildDo(
+		const StateType&           state,
+		Func                       func) const
+	{
+		transTable_.ForeachTupleWithChildDo(state, func);
+	}
+
 	static bool ShareTransTable(
 		const BDDBUTreeAutCore&       lhs,
 		const BDDBUTreeAutCore&       rhs)
@@ -435,6 +472,21 @@ public:   // methods
 		const StateType&       parent);
 
 
+	/**
+	 * @brief  Adds transitions from a tuple over many symbols at once
+	 *
+	 * Unlike calling AddTransition() for every transition, which unites a
+	 * single-path MTBDD into the transition table each time, this builds the
+	 * MTBDD of all transitions in a single pass (see TransMTBDD::Build()).
+	 *
+	 * @param[in]  children           The tuple of the transitions
+	 * @param[in]  symbolParentsList  Pairs of symbols and sets of parents
+	 */
+	void AddTransitions(
+		const StateTuple&                     children,
+		const TransMTBDD::AsgnValueList&      symbolParentsList);
+
+
 	BDDBUTreeAutCore RemoveUselessStates() const;
 
 
@@ -489,8 +541,39 @@ public:   // methods
 		const VATA::InclParam&      params);
 
 
+	/**
+	 * @brief  Upward inclusion checking by several threads
+	 *
+	 * The same as the upward antichain-based inclusion checking without
+	 * simulation, but the workset is processed by @p threadCnt threads sharing
+	 * the antichain. Since MTBDDs cannot be passed between threads, every
+	 * thread but the calling one works on its own copy of the automata. All
+	 * threads stop as soon as one of them finds a counterexample.
+	 *
+	 * @param[in]  smaller    The automaton with the smaller language
+	 * @param[in]  bigger     The automaton with the bigger language
+	 * @param[in]  threadCnt  The number of threads (0 for the number of cores)
+	 *
+	 * @returns  @p true if the language of @p smaller is included in the
+	 *           language of @p bigger, @p false otherwise
+	 */
+	static bool ParallelCheckUpwardInclusion(
+		const BDDBUTreeAutCore&     smaller,
+		const BDDBUTreeAutCore&     bigger,
+		size_t                      threadCnt);
+
+
 	BDDTDTreeAutCore GetTopDownAut() const;
 
+
+	static BDDBUTreeAutCore FromExplicit(
+		const ExplicitTreeAut&                                aut,
+		const BDDBottomUpTreeAut::ExplicitSymbolEncoding&     encoding);
+
+
+	ExplicitTreeAut ToExplicit(
+		const BDDBottomUpTreeAut::ExplicitSymbolEncoding&     encoding) const;
+
 	StateBinaryRelation ComputeSimulation(
 		const SimParam&                 params) const;
 
@@ -0,0 +1,108 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Conversion between BDD bottom-up and explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/explicit_tree_aut.hh>
+
+#include "bdd_bu_tree_aut_core.hh"
+#include "explicit_symbol_decoder.hh"
+
+// Standard library headers
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using VATA::BDDBUTreeAutCore;
+using VATA::ExplicitSymbolDecoder;
+using VATA::ExplicitTreeAut;
+
+
+BDDBUTreeAutCore BDDBUTreeAutCore::FromExplicit(
+	const ExplicitTreeAut&                                aut,
+	const BDDBottomUpTreeAut::ExplicitSymbolEncoding&     encoding)
+{
+	using ParentsBySymbol   = std::unordered_map<ExplicitTreeAut::SymbolType,
+		std::vector<StateType>>;
+	using TupleMap          = std::unordered_map<StateTuple, ParentsBySymbol,
+		boost::hash<StateTuple>>;
+
+	// group the transitions so that there is a single leaf for every tuple and
+	// symbol
+	TupleMap tupleMap;
+	for (const ExplicitTreeAut::Transition& trans : aut)
+	{
+		tupleMap[trans.GetChildren()][trans.GetSymbol()].push_back(
+			trans.GetParent());
+	}
+
+	BDDBUTreeAutCore result;
+
+	for (const auto& tupleSymbolsPair : tupleMap)
+	{
+		TransMTBDD::AsgnValueList symbolParentsList;
+		for (const auto& symbolParentsPair : tupleSymbolsPair.second)
+		{
+			const SymbolType& symbol = encoding.at(symbolParentsPair.first);
+			assert(symbol.length() == SYMBOL_SIZE);
+
+			symbolParentsList.push_back(std::make_pair(symbol,
+				StateSet(StateSet::SetType(symbolParentsPair.second))));
+		}
+
+		result.AddTransitions(tupleSymbolsPair.first, symbolParentsList);
+	}
+
+	for (const StateType& fst : aut.GetFinalStates())
+	{
+		result.SetStateFinal(fst);
+	}
+
+	return result;
+}
+
+
+ExplicitTreeAut BDDBUTreeAutCore::ToExplicit(
+	const BDDBottomUpTreeAut::ExplicitSymbolEncoding&     encoding) const
+{
+	ExplicitTreeAut result;
+
+	const ExplicitSymbolDecoder decoder(encoding);
+
+	for (auto tupleBddPair : this->GetTransTable())
+	{
+		const StateTuple& children = tupleBddPair.first;
+		const TransMTBDD& mtbdd = tupleBddPair.second;
+
+		// every path of the MTBDD to a nonempty leaf is visited once and mapped
+		// to the symbols it covers
+		mtbdd.ForEachAssignment([&](const SymbolicVarAsgn& asgn)
+		{
+			// the path is followed again, untested variables go low
+			const StateSet& parents = mtbdd.GetValue(asgn);
+
+			decoder.ForEachSymbol(asgn,
+				[&](const ExplicitSymbolDecoder::ExplicitSymbol& symbol)
+				{
+					for (const StateType& parent : parents)
+					{
+						result.AddTransition(children, symbol, parent);
+					}
+				});
+		}, SYMBOL_SIZE);
+	}
+
+	for (const StateType& fst : this->GetFinalStates())
+	{
+		result.SetStateFinal(fst);
+	}
+
+	return result;
+}
@@ -53,6 +53,12 @@ bool BDDBUTreeAutCore::CheckInclusion(
 		{
 			assert(static_cast<typename AutBase::StateType>(-1) != states);
 
+			if (1 != params.GetThreadCount())
+			{
+				return ParallelCheckUpwardInclusion(newSmaller, newBigger,
+					params.GetThreadCount());
+			}
+
 			return CheckUpwardTreeInclusion<BDDBUTreeAutCore,
 				VATA::UpwardInclusionFunctor>(newSmaller, newBigger,
 					Util::Identity(states));
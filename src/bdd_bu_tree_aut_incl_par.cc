@@ -0,0 +1,482 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of parallel upward inclusion on BDD bottom-up tree
+ *    automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/util/antichain2c_v2.hh>
+
+// Standard library headers
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "bdd_bu_tree_aut_core.hh"
+
+using VATA::BDDBUTreeAutCore;
+
+namespace
+{
+	using StateType        = BDDBUTreeAutCore::StateType;
+	using StateTuple       = BDDBUTreeAutCore::StateTuple;
+	using StateSet         = BDDBUTreeAutCore::StateSet;
+	using StateTupleSet    = BDDBUTreeAutCore::StateTupleSet;
+	using StateHT          = BDDBUTreeAutCore::StateHT;
+	using TransMTBDD       = BDDBUTreeAutCore::TransMTBDD;
+	using TupleId          = BDDBUTreeAutCore::TupleId;
+
+	/**
+	 * @brief  Set of states that may be passed between threads
+	 *
+	 * Leaves of the MTBDDs (StateSet) are interned in a store of their thread,
+	 * so the threads exchange plain sets.
+	 */
+	using SharedStateSet   = StateSet::SetType;
+	using ExportedMTBDD    = TransMTBDD::ExportedMTBDD<SharedStateSet>;
+	using StateSetTuple    = std::vector<std::set<StateType>>;
+
+
+	/**
+	 * @brief  An automaton detached from the MTBDD tables of its thread
+	 */
+	struct ExportedAut
+	{
+		std::vector<std::pair<StateTuple, ExportedMTBDD>> transitions;
+		StateHT finalStates;
+
+		ExportedAut() :
+			transitions(),
+			finalStates()
+		{ }
+	};
+
+
+	ExportedAut exportAut(const BDDBUTreeAutCore& aut)
+	{
+		ExportedAut result;
+
+		for (auto tupleBddPair : aut.GetTransTable())
+		{
+			result.transitions.push_back(std::make_pair(tupleBddPair.first,
+				tupleBddPair.second.Export<SharedStateSet>(
+					[](const StateSet& set){ return set.Get(); })));
+		}
+
+		result.finalStates = aut.GetFinalStates();
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  Creates a copy of an exported automaton in the calling thread
+	 */
+	BDDBUTreeAutCore importAut(const ExportedAut& exported)
+	{
+		BDDBUTreeAutCore result;
+
+		for (const auto& tupleBddPair : exported.transitions)
+		{
+			result.SetMtbdd(tupleBddPair.first, TransMTBDD::Import(
+				tupleBddPair.second,
+				[](const SharedStateSet& set){ return StateSet(set); }));
+		}
+
+		for (const StateType& fst : exported.finalStates)
+		{
+			result.SetStateFinal(fst);
+		}
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  Antichain and workset shared by the threads
+	 *
+	 * All operations lock a single mutex. A thread that finds the workset empty
+	 * waits until some other thread adds a new element, or until no thread
+	 * processes any element, in which case the checking is finished.
+	 */
+	class SharedInclusionState
+	{
+	private:  // data types
+
+		using AntichainType = VATA::Util::Antichain2Cv2<StateType, SharedStateSet>;
+
+	private:  // data members
+
+		std::mutex mutex_;
+		std::condition_variable cond_;
+
+		AntichainType antichain_;
+		AntichainType workset_;
+
+		/// the number of elements of the workset being processed
+		size_t busy_;
+
+		std::atomic<bool> failed_;
+
+	private:  // methods
+
+		SharedInclusionState(const SharedInclusionState&);
+		SharedInclusionState& operator=(const SharedInclusionState&);
+
+		static bool lteComparer(const SharedStateSet& lhs, const SharedStateSet& rhs)
+		{
+			return lhs.IsSubsetOf(rhs);
+		}
+
+		static bool gteComparer(const SharedStateSet& lhs, const SharedStateSet& rhs)
+		{
+			return rhs.IsSubsetOf(lhs);
+		}
+
+	public:   // methods
+
+		SharedInclusionState() :
+			mutex_(),
+			cond_(),
+			antichain_(),
+			workset_(),
+			busy_(0),
+			failed_(false)
+		{ }
+
+		bool IsImplied(const StateType& smallerState, const SharedStateSet& biggerSet)
+		{
+			std::vector<StateType> tmpList = {smallerState};
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			return antichain_.contains(tmpList, biggerSet, lteComparer);
+		}
+
+		/**
+		 * @brief  Adds a pair to the antichain and the workset
+		 *
+		 * Nothing happens if the pair is implied by the antichain.
+		 */
+		void CachePair(const StateType& smallerState, const SharedStateSet& biggerSet)
+		{
+			std::vector<StateType> tmpList = {smallerState};
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (antichain_.contains(tmpList, biggerSet, lteComparer))
+			{	// the pair is implied by the antichain
+				return;
+			}
+
+			antichain_.refine(tmpList, biggerSet, gteComparer);
+			antichain_.insert(smallerState, biggerSet);
+
+			if (!workset_.contains(tmpList, biggerSet, lteComparer))
+			{	// if the element is not implied by the workset
+				workset_.refine(tmpList, biggerSet, gteComparer);
+				workset_.insert(smallerState, biggerSet);
+				cond_.notify_one();
+			}
+		}
+
+		/**
+		 * @brief  Collects the states of all sets paired with a state
+		 *
+		 * @returns  @p false if @p smallerState is not in the antichain
+		 */
+		bool CollectBiggerStates(const StateType& smallerState,
+			std::set<StateType>& states)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			const AntichainType::TList* keyList = antichain_.lookup(smallerState);
+			if (nullptr == keyList)
+			{
+				return false;
+			}
+
+			assert(keyList->begin() != keyList->end());
+			for (const SharedStateSet& biggerSet : *keyList)
+			{
+				states.insert(biggerSet.begin(), biggerSet.end());
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief  Takes an element of the workset to be processed
+		 *
+		 * Blocks until there is an element to be processed. The caller needs to
+		 * call Done() after processing the element.
+		 *
+		 * @returns  @p false if the checking is finished
+		 */
+		bool Get(StateType& smallerState, SharedStateSet& biggerSet)
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cond_.wait(lock, [this]
+				{ return failed_ || !workset_.empty() || (0 == busy_); });
+
+			if (failed_ || workset_.empty())
+			{	// nothing to be processed any more
+				cond_.notify_all();
+				return false;
+			}
+
+			workset_.get(smallerState, biggerSet);
+			++busy_;
+
+			return true;
+		}
+
+		void Done()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			assert(busy_ > 0);
+			if ((0 == --busy_) && workset_.empty())
+			{	// the waiting threads may finish
+				cond_.notify_all();
+			}
+		}
+
+		/**
+		 * @brief  Stops all threads after a counterexample has been found
+		 */
+		void Fail()
+		{
+			failed_ = true;
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			cond_.notify_all();
+		}
+
+		bool HasFailed() const
+		{
+			return failed_;
+		}
+	};
+
+
+	/**
+	 * @brief  Upward inclusion functor working on the shared antichain
+	 *
+	 * The same as UpwardInclusionFunctor, except that the pairs are stored in
+	 * SharedInclusionState.
+	 */
+	class ParallelUpwardInclusionFunctor
+	{
+	private:  // data members
+
+		const BDDBUTreeAutCore& smaller_;
+		const BDDBUTreeAutCore& bigger_;
+
+		SharedInclusionState& shared_;
+
+	private:  // methods
+
+		ParallelUpwardInclusionFunctor(const ParallelUpwardInclusionFunctor&);
+		ParallelUpwardInclusionFunctor& operator=(
+			const ParallelUpwardInclusionFunctor&);
+
+	public:   // methods
+
+		ParallelUpwardInclusionFunctor(const BDDBUTreeAutCore& smaller,
+			const BDDBUTreeAutCore& bigger, SharedInclusionState& shared) :
+			smaller_(smaller),
+			bigger_(bigger),
+			shared_(shared)
+		{ }
+
+		template <class ElementAccessorLHS, class ElementAccessorRHS>
+		void operator()(const StateSet& lhs, ElementAccessorLHS lhsElemAccess,
+			const StateSet& rhs, ElementAccessorRHS rhsElemAccess)
+		{
+			const SharedStateSet& biggerSet = rhs.Get();
+
+			for (auto stateLhsElem : lhs)
+			{
+				const StateType& stateLhs = lhsElemAccess(stateLhsElem);
+				if (shared_.IsImplied(stateLhs, biggerSet))
+				{	// in case the pair need not be explored
+					continue;
+				}
+
+				if (smaller_.IsStateFinal(stateLhs))
+				{	// if the state is final in the smaller automaton
+					bool rhsHasFinal = false;
+					for (auto stateRhsElem : rhs)
+					{
+						if (bigger_.IsStateFinal(rhsElemAccess(stateRhsElem)))
+						{
+							rhsHasFinal = true;
+							break;
+						}
+					}
+
+					if (!rhsHasFinal)
+					{	// in case there is a counterexample
+						shared_.Fail();
+						return;
+					}
+				}
+
+				shared_.CachePair(stateLhs, biggerSet);
+			}
+		}
+
+		inline bool IsProcessingStopped() const
+		{
+			return shared_.HasFailed();
+		}
+	};
+
+
+	/**
+	 * @brief  Generates all tuples from a tuple of sets of states
+	 */
+	template <class Func>
+	void forEachChoice(const StateSetTuple& domain, StateTuple& tuple,
+		size_t index, Func& func)
+	{
+		if (index == domain.size())
+		{
+			func(tuple);
+			return;
+		}
+
+		for (const StateType& state : domain[index])
+		{
+			tuple[index] = state;
+			forEachChoice(domain, tuple, index + 1, func);
+		}
+	}
+
+
+	/**
+	 * @brief  Processes the workset until the checking is finished
+	 */
+	void processWorkset(const BDDBUTreeAutCore& smaller,
+		const BDDBUTreeAutCore& bigger, SharedInclusionState& shared)
+	{
+		ParallelUpwardInclusionFunctor upFctor(smaller, bigger, shared);
+
+		StateType procState;
+		SharedStateSet procSet;
+		while (shared.Get(procState, procSet))
+		{
+			smaller.ForeachTupleWithChildDo(procState, [&](const StateTuple& tuple,
+				const TransMTBDD& /* bdd */, const TupleId& /* id */)
+			{	// for each tuple with the processed state in the smaller aut
+				if (shared.HasFailed())
+				{	// another thread has found a counterexample
+					return;
+				}
+
+				// create a tuple of sets of states
+				StateSetTuple stateSetTuple(tuple.size());
+				for (size_t index = 0; index < tuple.size(); ++index)
+				{
+					if (tuple[index] == procState)
+					{	// special processing for the processed state
+						stateSetTuple[index].insert(procSet.begin(), procSet.end());
+					}
+					else if (!shared.CollectBiggerStates(tuple[index],
+						stateSetTuple[index]))
+					{	// if the tuple is not reachable yet
+						return;
+					}
+				}
+
+				// generate all tuples (none if some of the sets is empty)
+				StateTupleSet tupleSet;
+				StateTuple choice(tuple.size());
+				auto insertFunc = [&tupleSet](const StateTuple& tup)
+				{
+					tupleSet.insert(tup);
+				};
+				forEachChoice(stateSetTuple, choice, 0, insertFunc);
+
+				BDDBUTreeAutCore::ForeachUpSymbolFromTupleAndTupleSetDo(smaller,
+					bigger, tuple, tupleSet, upFctor);
+			});
+
+			shared.Done();
+		}
+	}
+}
+
+
+bool BDDBUTreeAutCore::ParallelCheckUpwardInclusion(
+	const BDDBUTreeAutCore&     smaller,
+	const BDDBUTreeAutCore&     bigger,
+	size_t                      threadCnt)
+{
+	if (0 == threadCnt)
+	{
+		threadCnt = std::thread::hardware_concurrency();
+	}
+
+	if (threadCnt <= 1)
+	{	// the sequential checking
+		InclParam params;
+		params.SetAlgorithm(InclParam::e_algorithm::antichains);
+		params.SetDirection(InclParam::e_direction::upward);
+		params.SetUseSimulation(false);
+
+		return BDDBUTreeAutCore::CheckInclusion(smaller, bigger, params);
+	}
+
+	SharedInclusionState shared;
+
+	// leaves of the empty tuple
+	{
+		ParallelUpwardInclusionFunctor upFctor(smaller, bigger, shared);
+
+		StateTuple tuple;
+		StateTupleSet tupleSet = {tuple};
+		ForeachUpSymbolFromTupleAndTupleSetDo(smaller, bigger, tuple, tupleSet,
+			upFctor);
+
+		if (shared.HasFailed())
+		{	// in case a counterexample was found
+			return false;
+		}
+	}
+
+	// the other threads work on their own copies of the automata
+	ExportedAut exportedSmaller = exportAut(smaller);
+	ExportedAut exportedBigger = exportAut(bigger);
+
+	auto worker = [&]()
+	{
+		BDDBUTreeAutCore localSmaller = importAut(exportedSmaller);
+		BDDBUTreeAutCore localBigger = importAut(exportedBigger);
+
+		processWorkset(localSmaller, localBigger, shared);
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCnt; ++i)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	processWorkset(smaller, bigger, shared);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return !shared.HasFailed();
+}
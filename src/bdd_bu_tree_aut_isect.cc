@@ -29,6 +29,7 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 	typedef std::map<StateType, StatePair> WorkSetType;
 	typedef AutBase::ProductTranslMap IntersectionTranslMap;
 	typedef BDDBUTreeAutCore::TransMTBDD MTBDD;
+	typedef BDDBUTreeAutCore::TupleId TupleId;
 	typedef VATA::Util::TranslatorWeak<IntersectionTranslMap> StateTranslator;
 
 	GCC_DIAG_OFF(effc++)
@@ -49,7 +50,7 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 
 		StateSet ApplyOperation(const StateSet& lhs, const StateSet& rhs)
 		{
-			StateSet result;
+			StateSet::SetType result;
 
 			for (const StateType& lhsState : lhs)
 			{
@@ -71,7 +72,7 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 
 	BDDBUTreeAutCore result;
 	WorkSetType workset;
-	StateType stateCnt;
+	StateType stateCnt = 0;
 
 	StateTranslator stateTransl(*pTranslMap,
 		[&workset,&stateCnt](const StatePair& newPair) -> StateType
@@ -100,9 +101,9 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 			result.SetStateFinal(newState);
 		}
 
-		for (auto lhsTupleBddPair : lhs.GetTransTable())
-		{
-			const StateTuple& lhsTuple = lhsTupleBddPair.first;
+		lhs.ForeachTupleWithChildDo(procPair.first, [&](
+			const StateTuple& lhsTuple, const MTBDD& lhsBdd, const TupleId&)
+		{	// for tuples with the first processed state
 			const size_t& arity = lhsTuple.size();
 
 			size_t firstMatch;
@@ -114,17 +115,14 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 				}
 			}
 
-			if (firstMatch == arity)
-			{	// if the first processed state is not present
-				continue;
-			}
+			assert(firstMatch < arity);
 
-			for (auto rhsTupleBddPair : rhs.GetTransTable())
-			{
-				const StateTuple& rhsTuple = rhsTupleBddPair.first;
+			rhs.ForeachTupleWithChildDo(procPair.second, [&](
+				const StateTuple& rhsTuple, const MTBDD& rhsBdd, const TupleId&)
+			{	// for tuples with the second processed state
 				if (rhsTuple.size() != arity)
 				{	// skip tuples of different size
-					continue;
+					return;
 				}
 
 				size_t i;
@@ -138,7 +136,7 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 
 				if (i == arity)
 				{	// if there was no match for the pair
-					continue;
+					return;
 				}
 
 				StateTuple tuple;
@@ -165,11 +163,10 @@ BDDBUTreeAutCore BDDBUTreeAutCore::Intersection(
 
 				if (tuple.size() == arity)
 				{	// in case all positions match
-					result.SetMtbdd(tuple,
-						isect(lhsTupleBddPair.second, rhsTupleBddPair.second));
+					result.SetMtbdd(tuple, isect(lhsBdd, rhsBdd));
 				}
-			}
-		}
+			});
+		});
 
 		// remove the processed state from the workset
 		workset.erase(itWs);
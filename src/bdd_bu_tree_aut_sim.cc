@@ -45,6 +45,8 @@ typedef std::pair<StateTuple, StateTuple> RemoveElement;
 typedef std::unordered_set<RemoveElement, boost::hash<RemoveElement>> RemoveSet;
 
 typedef BDDBUTreeAutCore::TransTable BUTransTable;
+typedef BDDBUTreeAutCore::TransMTBDD TransMTBDD;
+typedef BDDBUTreeAutCore::TupleId TupleId;
 
 namespace
 {	// anonymous namespace
@@ -53,10 +55,9 @@ void forAllTuplesWithMatchingStatesDo(
 	const BUTransTable& tuples, const StateType& lhsState,
 	const StateType& rhsState, ArbitraryFunction func)
 {
-	for (auto lhsTupleBddPair : tuples)
-	{
-		const StateTuple& lhsTuple = lhsTupleBddPair.first;
-
+	tuples.ForeachTupleWithChildDo(lhsState, [&](const StateTuple& lhsTuple,
+		const TransMTBDD&, const TupleId&)
+	{	// for tuples with the left-hand side state
 		std::vector<size_t> matchedPositions;
 		for (size_t i = 0; i < lhsTuple.size(); ++i)
 		{
@@ -66,18 +67,14 @@ void forAllTuplesWithMatchingStatesDo(
 			}
 		}
 
-		if (matchedPositions.empty())
-		{
-			continue;
-		}
-
-		for (auto rhsTupleBddPair : tuples)
-		{
-			const StateTuple& rhsTuple = rhsTupleBddPair.first;
+		assert(!matchedPositions.empty());
 
+		tuples.ForeachTupleWithChildDo(rhsState, [&](const StateTuple& rhsTuple,
+			const TransMTBDD&, const TupleId&)
+		{	// for tuples with the right-hand side state
 			if (rhsTuple.size() != lhsTuple.size())
 			{
-				continue;
+				return;
 			}
 
 			size_t i;
@@ -91,12 +88,12 @@ void forAllTuplesWithMatchingStatesDo(
 
 			if (i == matchedPositions.size())
 			{
-				continue;
+				return;
 			}
 
 			func(lhsTuple, rhsTuple);
-		}
-	}
+		});
+	});
 }
 
 inline bool componentWiseSim(const StateBinaryRelation& sim,
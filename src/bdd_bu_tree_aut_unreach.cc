@@ -24,8 +24,7 @@ using StateSet    = BDDBUTreeAutCore::StateSet;
 using StateHT     = BDDBUTreeAutCore::StateHT;
 using StateTuple  = BDDBUTreeAutCore::StateTuple;
 using TransMTBDD  = BDDBUTreeAutCore::TransMTBDD;
-
-using TupleHT = std::unordered_map<StateTuple, TransMTBDD, boost::hash<StateTuple>>;
+using TupleId     = BDDBUTreeAutCore::TupleId;
 
 
 namespace
@@ -83,14 +82,8 @@ BDDBUTreeAutCore BDDBUTreeAutCore::RemoveUnreachableStates(
 
 	StateHT workset;
 
-	TupleHT tuples;
-
-	for (auto tupleBddPair : this->GetTransTable())
-	{
-		tuples.insert(tupleBddPair);
-	}
-
-	tuples.erase(StateTuple());
+	// tuples whose states have all been found reachable
+	std::vector<bool> processed(transTable_.GetTupleIdCount(), false);
 
 	ReachableCollectorFctor reachFunc(*reachable, workset);
 
@@ -103,40 +96,28 @@ BDDBUTreeAutCore BDDBUTreeAutCore::RemoveUnreachableStates(
 		StateType state = *(workset.begin());
 		workset.erase(workset.begin());
 
-		TupleHT::const_iterator itTup = tuples.begin();
-		while (itTup != tuples.end())
-		{
-			const StateTuple& tuple = itTup->first;
+		this->ForeachTupleWithChildDo(state, [&](const StateTuple& tuple,
+			const TransMTBDD& bdd, const TupleId& id)
+		{	// for tuples with the state
+			if (processed[id])
+			{
+				return;
+			}
 
-			if (std::find(tuple.begin(), tuple.end(), state) != tuple.end())
-			{	// if the state is there
-				size_t i;
-				for (i = 0; i < tuple.size(); ++i)
+			for (const StateType& child : tuple)
+			{
+				if (reachable->find(child) == reachable->end())
 				{
-					if (reachable->find(tuple[i]) == reachable->end())
-					{
-						break;
-					}
-				}
-
-				if (i == tuple.size())
-				{	// in case all states are reachable
-
-					// collect reachable states
-					reachFunc(itTup->second);
-
-					result.SetMtbdd(tuple, itTup->second);
-
-					// remove the tuple from the set of tuples
-					decltype(itTup) tmpIt = itTup;
-					++itTup;
-					tuples.erase(tmpIt);
-					continue;
+					return;
 				}
 			}
 
-			++itTup;
-		}
+			// in case all states are reachable, collect reachable states
+			processed[id] = true;
+			reachFunc(bdd);
+
+			result.SetMtbdd(tuple, bdd);
+		});
 	}
 
 	for (const StateType& fst : this->GetFinalStates())
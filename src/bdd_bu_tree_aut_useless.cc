@@ -28,9 +28,7 @@ typedef VATA::BDDBUTreeAutCore::StateSet StateSet;
 typedef VATA::BDDBUTreeAutCore::StateHT StateHT;
 typedef VATA::BDDBUTreeAutCore::StateTuple StateTuple;
 typedef VATA::BDDBUTreeAutCore::TransMTBDD TransMTBDD;
-
-typedef std::unordered_map<StateTuple, TransMTBDD, boost::hash<StateTuple>>
-	TupleHT;
+typedef VATA::BDDBUTreeAutCore::TupleId TupleId;
 
 typedef Graph::NodeType NodeType;
 
@@ -129,7 +127,7 @@ public:   // methods
 
 	StateSet ApplyOperation(const StateSet& value)
 	{
-		StateSet result;
+		StateSet::SetType result;
 
 		for (const StateType& state : value)
 		{
@@ -157,15 +155,10 @@ BDDBUTreeAutCore BDDBUTreeAutCore::RemoveUselessStates() const
 	Graph graph;
 	NodeToStateDict nodes;
 
-	TupleHT tuples;
-
-	for (auto tupleBddPair : this->GetTransTable())
-	{
-		tuples.insert(tupleBddPair);
-	}
+	// tuples whose states have all been found reachable
+	std::vector<bool> processed(transTable_.GetTupleIdCount(), false);
 
 	StateTuple tuple;
-	tuples.erase(tuple);
 
 	ReachableCollectorFctor reachFunc(reachable, workset, tuple, nodes, graph);
 
@@ -177,37 +170,27 @@ BDDBUTreeAutCore BDDBUTreeAutCore::RemoveUselessStates() const
 		StateType state = *(workset.begin());
 		workset.erase(workset.begin());
 
-		TupleHT::const_iterator itTup = tuples.begin();
-		while (itTup != tuples.end())
-		{
-			tuple = itTup->first;
+		this->ForeachTupleWithChildDo(state, [&](const StateTuple& childTuple,
+			const TransMTBDD& bdd, const TupleId& id)
+		{	// for tuples with the state
+			if (processed[id])
+			{
+				return;
+			}
 
-			if (std::find(tuple.begin(), tuple.end(), state) != tuple.end())
-			{	// if the state is there
-				size_t i;
-				for (i = 0; i < tuple.size(); ++i)
+			for (const StateType& child : childTuple)
+			{
+				if (reachable.find(child) == reachable.end())
 				{
-					if (reachable.find(tuple[i]) == reachable.end())
-					{
-						break;
-					}
-				}
-
-				if (i == tuple.size())
-				{	// in case all states are reachable
-					// collect reachable states
-					reachFunc(itTup->second);
-
-					// remove the tuple from the set of tuples
-					decltype(itTup) tmpIt = itTup;
-					++itTup;
-					tuples.erase(tmpIt);
-					continue;
+					return;
 				}
 			}
 
-			++itTup;
-		}
+			// in case all states are reachable, collect reachable states
+			processed[id] = true;
+			tuple = childTuple;
+			reachFunc(bdd);
+		});
 	}
 
 	NodeWorkSet nodeWorkset;
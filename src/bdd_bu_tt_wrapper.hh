@@ -25,41 +25,70 @@ private:  // data types
 	using Table           = VATA::Util::BDDBottomUpTransTable<MTBDDHandle, StateSet>;
 	using TablePtr        = std::shared_ptr<Table>;
 	using StateTuple      = typename Table::StateTuple;
+	using StateType       = typename Table::StateType;
 
 public:   // data types
 
 	using TransMTBDD      = typename Table::MTBDD;
-
-private:  // data types
-
-	using key_type    = typename Table::TupleMap::key_type;
-	using mapped_type = typename Table::TupleMap::mapped_type;
-	using value_type  = typename Table::TupleMap::value_type;
-
-
-	template <class TupleMapIterator>
-	class generic_iterator
+	using TupleId         = typename Table::TupleId;
+
+	/**
+	 * @brief  A tuple with its MTBDD
+	 *
+	 * Both are references into the table, so that iterating does not copy
+	 * them.
+	 */
+	using value_type  = std::pair<const StateTuple&, const TransMTBDD&>;
+
+	/**
+	 * @brief  Iterator over the nullary MTBDD and the tuples of the table
+	 */
+	GCC_DIAG_OFF(effc++)
+	class const_iterator
 	{
+	GCC_DIAG_ON(effc++)
+
 	private:  // data members
 
 		bool isNullary_;
 		const TransTableWrapper& tableWrap_;
-		TupleMapIterator itTupleMap_;
+		TupleId id_;
+
+	private:  // methods
+
+		void skipRemoved()
+		{
+			const Table& table = *tableWrap_.table_;
+			while ((id_ < table.GetTupleIdCount()) && !table.IsPresent(id_))
+			{
+				++id_;
+			}
+		}
 
 	public:   // methods
 
-		bool operator==(const generic_iterator& rhs) const
+		const_iterator(
+			const TransTableWrapper&       tableWrap,
+			bool                           isBegin) :
+			isNullary_(isBegin),
+			tableWrap_(tableWrap),
+			id_(isBegin? 0 : tableWrap.table_->GetTupleIdCount())
+		{
+			skipRemoved();
+		}
+
+		bool operator==(const const_iterator& rhs) const
 		{
 			bool match = (isNullary_ == rhs.isNullary_);
-			return match && (isNullary_ || (itTupleMap_ == rhs.itTupleMap_));
+			return match && (isNullary_ || (id_ == rhs.id_));
 		}
 
-		bool operator!=(const generic_iterator& rhs) const
+		bool operator!=(const const_iterator& rhs) const
 		{
 			return !operator==(rhs);
 		}
 
-		generic_iterator& operator++()
+		const_iterator& operator++()
 		{
 			if (isNullary_)
 			{
@@ -67,91 +96,27 @@ private:  // data types
 			}
 			else
 			{
-				++itTupleMap_;
+				++id_;
+				skipRemoved();
 			}
 
 			return *this;
 		}
 
-	protected:// methods
-
-		generic_iterator(
-			const TransTableWrapper&      tableWrap,
-			bool                          isBegin) :
-			isNullary_(isBegin),
-			tableWrap_(tableWrap),
-			itTupleMap_(isBegin? tableWrap.table_->GetTupleMap().begin() :
-				tableWrap.table_->GetTupleMap().end())
-		{ }
-
-#if 0
-		inline value_type refOp()
+		value_type operator*() const
 		{
-			if (isNullary_)
-			{
-				assert(false);
-			}
-			else
-			{
-				return *itTupleMap_;
-			}
-		}
-#endif
+			static const StateTuple nullaryTuple;
 
-		value_type constRefOp() const
-		{
 			if (isNullary_)
 			{
-				return std::make_pair(StateTuple(), tableWrap_.nullaryMtbdd_);
+				return value_type(nullaryTuple, tableWrap_.nullaryMtbdd_);
 			}
 			else
 			{
-				return *itTupleMap_;
+				return value_type(tableWrap_.table_->GetTuple(id_),
+					tableWrap_.table_->GetMtbddById(id_));
 			}
 		}
-
-	};
-
-public:   // data types
-
-#if 0
-	GCC_DIAG_OFF(effc++)
-	class iterator :
-		public generic_iterator<typename Table::TupleMap::iterator>
-	{
-	GCC_DIAG_ON(effc++)
-
-	public:   // methods
-
-		iterator(const typename Table::TupleMap::iterator& iter, bool isNullary) :
-			generic_iterator(iter, isNullary)
-		{ }
-
-		inline value_type& operator*()
-		{
-			return refOp();
-		}
-	};
-#endif
-
-	GCC_DIAG_OFF(effc++)
-	class const_iterator :
-		public generic_iterator<typename Table::TupleMap::const_iterator>
-	{
-	GCC_DIAG_ON(effc++)
-
-	public:   // methods
-
-		const_iterator(
-			const TransTableWrapper&       tableWrap,
-			bool                           isBegin) :
-			generic_iterator<typename Table::TupleMap::const_iterator>(tableWrap, isBegin)
-		{ }
-
-		value_type operator*() const
-		{
-			return this->constRefOp();
-		}
 	};
 
 
@@ -211,6 +176,33 @@ public:   // methods
 		return table_;
 	}
 
+	/**
+	 * @brief  Calls @p func on every present tuple containing @p state
+	 *
+	 * @p func is called with the tuple, its MTBDD and its identifier, which is
+	 * lower than GetTupleIdCount(). The nullary tuple never contains any
+	 * state.
+	 */
+	template <class Func>
+	void ForeachTupleWithChildDo(
+		const StateType&               state,
+		Func                           func) const
+	{
+		const Table& table = *table_;
+		for (const TupleId& id : table.GetTuplesWithChild(state))
+		{
+			if (table.IsPresent(id))
+			{
+				func(table.GetTuple(id), table.GetMtbddById(id), id);
+			}
+		}
+	}
+
+	size_t GetTupleIdCount() const
+	{
+		return table_->GetTupleIdCount();
+	}
+
 	bool unique() const
 	{
 		return table_.unique();
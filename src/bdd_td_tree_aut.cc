@@ -163,6 +163,24 @@ BDDTopDownTreeAut BDDTopDownTreeAut::Intersection(
 }
 
 
+BDDTopDownTreeAut BDDTopDownTreeAut::FromExplicit(
+	const ExplicitTreeAut&        aut,
+	const ExplicitSymbolEncoding& encoding)
+{
+	return BDDTopDownTreeAut(
+		CoreAut(BDDTDTreeAutCore::FromExplicit(aut, encoding)));
+}
+
+
+VATA::ExplicitTreeAut BDDTopDownTreeAut::ToExplicit(
+	const ExplicitSymbolEncoding& encoding) const
+{
+	assert(nullptr != core_);
+
+	return core_->ToExplicit(encoding);
+}
+
+
 BDDTopDownTreeAut BDDTopDownTreeAut::RemoveUnreachableStates() const
 {
 	assert(nullptr != core_);
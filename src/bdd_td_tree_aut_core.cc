@@ -15,6 +15,8 @@
 using VATA::BDDTDTreeAutCore;
 using VATA::Util::Convert;
 
+const size_t BDDTDTreeAutCore::SYMBOL_TOTAL_SIZE;
+
 
 BDDTDTreeAutCore::BDDTDTreeAutCore(AlphabetType& alphabet) :
 	SymbolicTreeAutBaseCore(alphabet),
@@ -104,6 +106,26 @@ void BDDTDTreeAutCore::AddTransition(
 }
 
 
+void BDDTDTreeAutCore::AddTransitions(
+	const StateType&                      parent,
+	const TransMTBDD::AsgnValueList&      symbolTuplesList)
+{
+	if (transTable_.unique())
+	{
+		UnionApplyFunctor unioner;
+
+		TransMTBDD addedMtbdd = TransMTBDD::Build(symbolTuplesList,
+			StateTupleSet(), [](const StateTupleSet& lhs, const StateTupleSet& rhs)
+			{ return lhs.Union(rhs); });
+		SetMtbdd(parent, unioner(GetMtbdd(parent), addedMtbdd));
+	}
+	else
+	{	// copy on write
+		assert(false);              // fail gracefully
+	}
+}
+
+
 std::string BDDTDTreeAutCore::DumpToDot() const
 {
 	std::vector<const TransMTBDD*> stateVec;
@@ -138,7 +160,7 @@ void BDDTDTreeAutCore::ReindexStates(
 
 		StateTupleSet ApplyOperation(const StateTupleSet& value)
 		{
-			StateTupleSet result;
+			StateTupleSet::SetType result;
 
 			for (const StateTuple& tuple : value)
 			{ // for every tuple
@@ -27,6 +27,7 @@
 #include "mtbdd/void_apply2func.hh"
 
 #include "util/bdd_td_trans_table.hh"
+#include "util/interned_set.hh"
 #include "symbolic_tree_aut_base_core.hh"
 #include "bdd_bu_tree_aut_core.hh"
 
@@ -44,7 +45,7 @@ GCC_DIAG_ON(effc++)
 
 public:   // data types
 
-	using StateTupleSet             = Util::OrdVector<StateTuple>;
+	using StateTupleSet             = Util::InternedSet<StateTuple>;
 	using DownInclStateTupleSet     = StateTupleSet;
 	using DownInclStateTupleVector  = std::vector<StateTuple>;
 
@@ -71,6 +72,10 @@ private:  // data types
 			StateTupleSet>
 	{
 	GCC_DIAG_ON(effc++)
+	public:   // constants
+
+		static const bool SHARED_CACHE = true;
+
 	public:   // methods
 
 		StateTupleSet ApplyOperation(
@@ -117,6 +122,10 @@ private:  // methods
 			finalStates_.insert(stateTransl(fst));
 		}
 
+		// transitions grouped by parents (in the order of their first occurrence)
+		std::vector<std::pair<StateType, TransMTBDD::AsgnValueList>> parentList;
+		std::unordered_map<StateType, size_t> parentIndex;
+
 		for (auto tr : desc.transitions)
 		{	// traverse the transitions
 			const AutDescription::StateTuple& childrenStr = tr.first;
@@ -135,8 +144,24 @@ private:  // methods
 
 			// translate the symbol
 			SymbolType symbol = symbolTransl(symbolStr);
+			assert(symbol.length() == SYMBOL_SIZE);
+			addArityToSymbol(symbol, children.size());
+
+			auto itIndex = parentIndex.insert(
+				std::make_pair(parent, parentList.size())).first;
+			if (parentList.size() == itIndex->second)
+			{	// in case the parent is new
+				parentList.push_back(
+					std::make_pair(parent, TransMTBDD::AsgnValueList()));
+			}
+
+			parentList[itIndex->second].second.push_back(
+				std::make_pair(symbol, StateTupleSet(children)));
+		}
 
-			AddTransition(children, symbol, parent);
+		for (const auto& parentTransPair : parentList)
+		{	// build the MTBDDs
+			AddTransitions(parentTransPair.first, parentTransPair.second);
 		}
 	}
 
@@ -444,6 +469,20 @@ public:   // methods
 		const StateType&        parent);
 
 
+	/**
+	 * @brief  Adds transitions from a state over many symbols at once
+	 *
+	 * The same as BDDBUTreeAutCore::AddTransitions(), except that the symbols
+	 * already contain the arity of their tuples.
+	 *
+	 * @param[in]  parent             The parent state of the transitions
+	 * @param[in]  symbolTuplesList   Pairs of symbols and sets of tuples
+	 */
+	void AddTransitions(
+		const StateType&                      parent,
+		const TransMTBDD::AsgnValueList&      symbolTuplesList);
+
+
 #if 0
 	void AddSimplyTransition(
 		const StateTuple&     children,
@@ -630,6 +669,15 @@ public:   // methods
 		const BDDTDTreeAutCore&       smaller,
 		const BDDTDTreeAutCore&       bigger,
 		const VATA::InclParam&        params);
+
+
+	static BDDTDTreeAutCore FromExplicit(
+		const ExplicitTreeAut&                               aut,
+		const BDDTopDownTreeAut::ExplicitSymbolEncoding&     encoding);
+
+
+	ExplicitTreeAut ToExplicit(
+		const BDDTopDownTreeAut::ExplicitSymbolEncoding&     encoding) const;
 };
 
 
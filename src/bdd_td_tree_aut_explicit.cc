@@ -0,0 +1,112 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Conversion between BDD top-down and explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/explicit_tree_aut.hh>
+
+#include "bdd_td_tree_aut_core.hh"
+#include "explicit_symbol_decoder.hh"
+
+// Standard library headers
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using VATA::BDDTDTreeAutCore;
+using VATA::ExplicitSymbolDecoder;
+using VATA::ExplicitTreeAut;
+
+
+BDDTDTreeAutCore BDDTDTreeAutCore::FromExplicit(
+	const ExplicitTreeAut&                               aut,
+	const BDDTopDownTreeAut::ExplicitSymbolEncoding&     encoding)
+{
+	// the symbol together with the arity of the tuple
+	using RankedSymbol      = std::pair<ExplicitTreeAut::SymbolType, size_t>;
+	using TuplesBySymbol    = std::unordered_map<RankedSymbol,
+		std::vector<StateTuple>, boost::hash<RankedSymbol>>;
+	using ParentMap         = std::unordered_map<StateType, TuplesBySymbol>;
+
+	// group the transitions so that there is a single leaf for every parent
+	// and symbol
+	ParentMap parentMap;
+	for (const ExplicitTreeAut::Transition& trans : aut)
+	{
+		const StateTuple& children = trans.GetChildren();
+		parentMap[trans.GetParent()][std::make_pair(trans.GetSymbol(),
+			children.size())].push_back(children);
+	}
+
+	BDDTDTreeAutCore result;
+
+	for (const auto& parentSymbolsPair : parentMap)
+	{
+		TransMTBDD::AsgnValueList symbolTuplesList;
+		for (const auto& symbolTuplesPair : parentSymbolsPair.second)
+		{
+			SymbolType symbol = encoding.at(symbolTuplesPair.first.first);
+			assert(symbol.length() == SYMBOL_SIZE);
+			result.addArityToSymbol(symbol, symbolTuplesPair.first.second);
+
+			symbolTuplesList.push_back(std::make_pair(symbol,
+				StateTupleSet(StateTupleSet::SetType(symbolTuplesPair.second))));
+		}
+
+		result.AddTransitions(parentSymbolsPair.first, symbolTuplesList);
+	}
+
+	for (const StateType& fst : aut.GetFinalStates())
+	{
+		result.SetStateFinal(fst);
+	}
+
+	return result;
+}
+
+
+ExplicitTreeAut BDDTDTreeAutCore::ToExplicit(
+	const BDDTopDownTreeAut::ExplicitSymbolEncoding&     encoding) const
+{
+	ExplicitTreeAut result;
+
+	const ExplicitSymbolDecoder decoder(encoding);
+
+	for (auto stateBddPair : this->GetStates())
+	{
+		const StateType& parent = stateBddPair.first;
+		const TransMTBDD& mtbdd = this->GetMtbdd(parent);
+
+		// every path of the MTBDD to a nonempty leaf is visited once; the arity
+		// variables that follow the symbol are not decoded since every value of
+		// them is a valid arity and the leaf holds tuples of that arity
+		mtbdd.ForEachAssignment([&](const SymbolicVarAsgn& asgn)
+		{
+			// the path is followed again, untested variables go low
+			const StateTupleSet& tuples = mtbdd.GetValue(asgn);
+
+			decoder.ForEachSymbol(asgn,
+				[&](const ExplicitSymbolDecoder::ExplicitSymbol& symbol)
+				{
+					for (const StateTuple& children : tuples)
+					{
+						result.AddTransition(children, symbol, parent);
+					}
+				});
+		}, SYMBOL_TOTAL_SIZE);
+	}
+
+	for (const StateType& fst : this->GetFinalStates())
+	{
+		result.SetStateFinal(fst);
+	}
+
+	return result;
+}
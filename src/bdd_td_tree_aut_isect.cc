@@ -50,7 +50,7 @@ BDDTDTreeAutCore BDDTDTreeAutCore::Intersection(
 		StateTupleSet ApplyOperation(const StateTupleSet& lhs,
 			const StateTupleSet& rhs)
 		{
-			StateTupleSet result;
+			StateTupleSet::SetType result;
 
 			for (auto lhsTuple : lhs)
 			{
@@ -60,7 +60,7 @@ BDDTDTreeAutCore BDDTDTreeAutCore::Union(
 
 		StateTupleSet ApplyOperation(const StateTupleSet& value)
 		{
-			StateTupleSet result;
+			StateTupleSet::SetType result;
 
 			// TODO: nicer for
 			for (StateTupleSet::const_iterator itSts = value.begin();
@@ -239,7 +239,7 @@ BDDTDTreeAutCore BDDTDTreeAutCore::RemoveUselessStates() const
 
 		StateTupleSet ApplyOperation(const StateTupleSet& value)
 		{
-			StateTupleSet result;
+			StateTupleSet::SetType result;
 
 			for (const StateTuple& tuple : value)
 			{	// for each tuple from the leaf
@@ -0,0 +1,44 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the context of automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/context.hh>
+
+#include "util/cache.hh"
+
+
+using VATA::Context;
+
+
+Context::Context() :
+	explicitTreeTupleCache_(new ExplicitTreeTupleCache()),
+	explicitTreeAlphabet_(new ExplicitTreeAut::OnTheFlyAlphabet)
+{ }
+
+
+Context::~Context()
+{ }
+
+
+Context::ExplicitTreeTupleCache& Context::GetExplicitTreeTupleCache()
+{
+	assert(nullptr != explicitTreeTupleCache_);
+
+	return *explicitTreeTupleCache_;
+}
+
+
+Context::ExplicitTreeAlphabetType& Context::GetExplicitTreeAlphabet()
+{
+	assert(nullptr != explicitTreeAlphabet_);
+
+	return explicitTreeAlphabet_;
+}
@@ -25,22 +25,35 @@
 #include <vata/util/convert.hh>
 
 
+#include "util/bit_splitting_relation.hh"
+#include "util/bit_vector.hh"
 #include "util/caching_allocator.hh"
 #include "util/shared_counter.hh"
 #include "util/shared_list.hh"
 #include "util/splitting_relation.hh"
+#include "util/worker_pool.hh"
 
 
 using VATA::Util::BinaryRelation;
 using VATA::Util::SplittingRelation;
+using VATA::Util::BitSplittingRelation;
+using VATA::Util::BitVector;
 using VATA::Util::SmartSet;
 using VATA::Util::CachingAllocator;
 using VATA::Util::SharedList;
 using VATA::Util::SharedCounter;
 using VATA::Util::Convert;
+using VATA::Util::WorkerPool;
 
 typedef CachingAllocator<std::vector<size_t>> VectorAllocator;
 
+// the bit-matrix relation needs (blocks^2)/8 bytes, so it is used only for
+// LTSs with at most this number of states (i.e., at most 128 MB)
+const size_t BitMatrixMaxStates = 1 << 15;
+
+// the minimal number of blocks in a pre-list worth processing in parallel
+const size_t ParallelMinBlocks = 8;
+
 struct SharedListInitF {
 
 	VectorAllocator& allocator_;
@@ -259,6 +272,14 @@ public:
 
 };
 
+/**
+ * @brief  The simulation algorithm
+ *
+ * The @p Relation parameter is the representation of the relation on blocks,
+ * either SplittingRelation (linked lists of pairs, proportional to the size of
+ * the relation) or BitSplittingRelation (bit matrix with bulk row operations).
+ */
+template <class Relation>
 class SimulationEngine {
 
 protected:
@@ -312,7 +333,7 @@ protected:
 
 			assert(elem);
 
-			for (auto& q : this->lts_.pre(label)[elem->index_]) {
+			for (auto& q : this->lts_.pre(label, elem->index_)) {
 
 				auto& block = this->index_[q].block_;
 
@@ -392,7 +413,7 @@ protected:
 	}
 
 	template <class T>
-	void split(std::vector<bool>& removeMask, const T& remove) {
+	void split(BitVector& removeMask, const T& remove) {
 
 		std::vector<Block*> modifiedBlocks;
 
@@ -406,7 +427,7 @@ protected:
 
 			if (!p.first) {
 
-				removeMask[block->index_] = true;
+				removeMask.set(block->index_);
 
 				continue;
 
@@ -420,7 +441,7 @@ protected:
 
 			this->relation_.split(block->index_);
 
-			removeMask[newBlock->index_] = true;
+			removeMask.set(newBlock->index_);
 
 			newBlock->counter_.copyLabels(newBlock->inset_, block->counter_);
 
@@ -451,7 +472,7 @@ protected:
 
 		std::vector<Block*> preList;
 
-		std::vector<bool> removeMask(this->lts_.states());
+		BitVector removeMask(this->lts_.states());
 
 		this->buildPre(preList, block->states_, label);
 
@@ -464,44 +485,110 @@ protected:
 			}
 		);
 
+		if ((nullptr != this->pool_) && (preList.size() >= ParallelMinBlocks)) {
+			this->parallelRefine(preList, removeMask);
+
+			return;
+
+		}
+
 		for (auto& b1 : preList) {
 
-			SplittingRelation::Row row = this->relation_.row(b1->index_);
+			this->relation_.eraseMasked(b1->index_, removeMask, [this, b1](size_t col) {
 
-			for (auto col = row.begin(); col != row.end(); ++col) {
+				this->collectDecrements(b1, col, [this, b1](size_t a, size_t pre) {
 
-				if (!removeMask[*col])
-					continue;
+					if (!b1->counter_.decr(a, pre))
+						this->enqueueToRemove(b1, a, pre);
 
-				assert(b1->index_ != *col);
+				});
 
-				this->relation_.erase(col);
+			});
 
-				auto b2 = this->partition_[*col];
+		}
 
-				for (auto a : b2->inset_) {
+	}
 
-					if (!b1->inset_.contains(a))
-						continue;
+	/**
+	 * @brief  Calls @p f for every counter of @p b1 affected by removing @p col
+	 */
+	template <class F>
+	void collectDecrements(const Block* b1, size_t col, F f) const {
 
-					auto elem = b2->states_;
+		assert(b1->index_ != col);
 
-					do {
+		auto b2 = this->partition_[col];
 
-						assert(elem);
+		for (auto a : b2->inset_) {
 
-						for (auto& pre : this->lts_.pre(a)[elem->index_]) {
+			if (!b1->inset_.contains(a))
+				continue;
 
-							if (!b1->counter_.decr(a, pre))
-								this->enqueueToRemove(b1, a, pre);
+			auto elem = b2->states_;
 
-						}
+			do {
 
-						elem = elem->next_;
+				assert(elem);
 
-					} while (elem != b2->states_);
+				for (auto& pre : this->lts_.pre(a, elem->index_))
+					f(a, pre);
 
-				}
+				elem = elem->next_;
+
+			} while (elem != b2->states_);
+
+		}
+
+	}
+
+	/**
+	 * @brief  Parallel version of the refinement of the relation
+	 *
+	 * The rows of the blocks in @p preList are refined and the affected
+	 * counters are collected concurrently, since every block only touches its
+	 * own row. The counters (which share their storage among blocks) are then
+	 * updated sequentially in the same order as in the sequential version, so
+	 * the result does not depend on the number of threads.
+	 */
+	void parallelRefine(const std::vector<Block*>& preList, const BitVector& removeMask) {
+
+		assert(nullptr != this->pool_);
+
+		if (this->decrements_.size() < preList.size())
+			this->decrements_.resize(preList.size());
+
+		this->pool_->Run(preList.size(),
+			[this, &preList, &removeMask](size_t i, size_t worker) {
+
+				auto b1 = preList[i];
+				auto& decrements = this->decrements_[i];
+
+				decrements.clear();
+
+				this->relation_.eraseMasked(b1->index_, removeMask,
+					[this, b1, &decrements](size_t col) {
+
+						this->collectDecrements(b1, col, [&decrements](size_t a, size_t pre) {
+
+							decrements.push_back(std::make_pair(a, pre));
+
+						});
+
+					},
+					this->scratch_[worker]
+				);
+
+			}
+		);
+
+		for (size_t i = 0; i < preList.size(); ++i) {
+
+			auto b1 = preList[i];
+
+			for (auto& labelState : this->decrements_[i]) {
+
+				if (!b1->counter_.decr(labelState.first, labelState.second))
+					this->enqueueToRemove(b1, labelState.first, labelState.second);
 
 			}
 
@@ -585,13 +672,17 @@ private:
 	SharedCounter::Allocator counterAllocator_;
 
 	std::vector<Block*> partition_;
-	SplittingRelation relation_;
+	Relation relation_;
 
 	std::vector<StateListElem> index_;
 	RemoveQueue queue_;
 	std::vector<size_t> key_;
 	std::vector<std::pair<size_t, size_t>> labelMap_;
 
+	std::unique_ptr<WorkerPool> pool_;
+	std::vector<std::vector<BitVector::Word>> scratch_;
+	std::vector<std::vector<std::pair<size_t, size_t>>> decrements_;
+
 	SimulationEngine(const SimulationEngine&);
 
 	SimulationEngine& operator=(const SimulationEngine&);
@@ -612,13 +703,25 @@ private:
 
 public:
 
-	SimulationEngine(const VATA::ExplicitLTS& lts) : lts_(lts),
+	SimulationEngine(const VATA::ExplicitLTS& lts, size_t threadCnt = 1) : lts_(lts),
 		rowSize_(SimulationEngine::getRowSize(lts.states())), vectorAllocator_(),
 		removeAllocator_(SharedListInitF(vectorAllocator_)), counterAllocator_(rowSize_ + 1),
-		partition_(), relation_(lts.states()), index_(lts.states()), queue_(), key_(), labelMap_() {
+		partition_(), relation_(lts.states()), index_(lts.states()), queue_(), key_(), labelMap_(),
+		pool_(), scratch_(), decrements_() {
 
 		assert(this->index_.size());
 
+		if (Relation::ConcurrentRows && (1 != threadCnt)) {
+
+			this->pool_.reset(new WorkerPool(threadCnt));
+
+			if (1 == this->pool_->size())
+				this->pool_.reset();
+			else
+				this->scratch_.resize(this->pool_->size());
+
+		}
+
 	}
 
 	~SimulationEngine() {
@@ -676,8 +779,8 @@ public:
 		// prune relation
 
 		std::vector<std::vector<size_t>> pre(this->partition_.size());
-		std::vector<std::vector<bool>> noPreMask(
-			this->lts_.labels(), std::vector<bool>(this->partition_.size())
+		std::vector<BitVector> noPreMask(
+			this->lts_.labels(), BitVector(this->partition_.size())
 		);
 
 		for (auto& block : this->partition_) {
@@ -690,7 +793,7 @@ public:
 
 					delta1[a].contains(elem->index_)
 						? (pre[block->index_].push_back(a), true)
-						: (noPreMask[a][block->index_] = true);
+						: (noPreMask[a].set(block->index_), true);
 
 				}
 
@@ -700,27 +803,42 @@ public:
 
 		}
 
-		for (auto& b1 : this->partition_) {
+		// every block only prunes its own row, so the rows can be processed
+		// concurrently
+		auto pruneRow = [this, &pre, &noPreMask](size_t i, std::vector<BitVector::Word>& scratch) {
 
-			auto row = this->relation_.row(b1->index_);
+			auto b1 = this->partition_[i];
 
 			for (auto& a : pre[b1->index_]) {
 
-				for (auto col = row.begin(); col != row.end(); ++col) {
+				assert(a < noPreMask.size());
+
+				this->relation_.eraseMasked(b1->index_, noPreMask[a], [b1](size_t col) {
+
+					assert(b1->index_ != col);
+
+				}, scratch);
+
+			}
 
-					assert(a < noPreMask.size());
-					assert(*col < noPreMask[a].size());
+		};
 
-					if (!noPreMask[a][*col])
-						continue;
+		if (nullptr != this->pool_) {
 
-					assert(b1->index_ != *col);
+			this->pool_->Run(this->partition_.size(),
+				[this, &pruneRow](size_t i, size_t worker) {
 
-					this->relation_.erase(col);
+					pruneRow(i, this->scratch_[worker]);
 
 				}
+			);
 
-			}
+		} else {
+
+			std::vector<BitVector::Word> scratch;
+
+			for (size_t i = 0; i < this->partition_.size(); ++i)
+				pruneRow(i, scratch);
 
 		}
 
@@ -730,13 +848,14 @@ public:
 
 		for (auto& b1 : this->partition_) {
 
-			auto row = this->relation_.row(b1->index_);
-
 			std::vector<bool> relatedBlocks(this->partition_.size());
 
-			for (auto& col : row)
+			this->relation_.forEach(b1->index_, [&relatedBlocks](size_t col) {
+
 				relatedBlocks[col] = true;
 
+			});
+
 			size_t size = 0;
 
 			for (auto& a : b1->inset())
@@ -750,7 +869,7 @@ public:
 
 					size_t count = 0;
 
-					for (auto r : this->lts_.post(a)[q]) {
+					for (auto r : this->lts_.post(a, q)) {
 
 						if (relatedBlocks[this->index_[r].block_->index_])
 							++count;
@@ -764,7 +883,7 @@ public:
 
 				s.assignFlat(delta1[a]);
 
-				for (auto& col : row) {
+				this->relation_.forEach(b1->index_, [this, &s, a](size_t col) {
 
 					auto b2 = this->partition_[col];
 
@@ -772,14 +891,14 @@ public:
 
 					do {
 
-						for (auto& q : this->lts_.pre(a)[elem->index_])
+						for (auto& q : this->lts_.pre(a, elem->index_))
 							s.remove(q);
 
 						elem = elem->next_;
 
 					} while (elem != b2->states_);
 
-				}
+				});
 
 				if (s.empty())
 					continue;
@@ -837,16 +956,21 @@ public:
 
 		for (size_t i = 0; i < this->relation_.size(); ++i) {
 
-			for (auto j : const_cast<SplittingRelation*>(&this->relation_)->row(i)) {
+			if (tmp[i].empty())
+				continue;
+
+			// states of a block have identical rows
+			size_t first = tmp[i].front();
 
-				for (auto& r : tmp[i]) {
+			const_cast<Relation*>(&this->relation_)->forEach(i, [&result, &tmp, first](size_t j) {
 
-					for (auto& s : tmp[j])
-						result.set(r, s, true);
+				for (auto& s : tmp[j])
+					result.set(first, s, true);
 
-				}
+			});
 
-			}
+			for (size_t k = 1; k < tmp[i].size(); ++k)
+				result.rowOr(tmp[i][k], first);
 
 		}
 
@@ -872,7 +996,8 @@ public:
 BinaryRelation VATA::ExplicitLTS::computeSimulation(
 	const std::vector<std::vector<size_t>>& partition,
 	const BinaryRelation& relation,
-	size_t outputSize
+	size_t outputSize,
+	size_t threadCnt
 ) {
 
 	if (0 == states_)
@@ -880,14 +1005,24 @@ BinaryRelation VATA::ExplicitLTS::computeSimulation(
 		return BinaryRelation();
 	}
 
-	SimulationEngine engine(*this);
+	BinaryRelation result;
 
-	engine.init(partition, relation);
-	engine.run();
+	if (states_ <= BitMatrixMaxStates)
+	{
+		SimulationEngine<BitSplittingRelation> engine(*this, threadCnt);
 
-	BinaryRelation result;
+		engine.init(partition, relation);
+		engine.run();
+		engine.buildResult(result, outputSize);
+	}
+	else
+	{
+		SimulationEngine<SplittingRelation> engine(*this);
 
-	engine.buildResult(result, outputSize);
+		engine.init(partition, relation);
+		engine.run();
+		engine.buildResult(result, outputSize);
+	}
 
 	return result;
 }
@@ -0,0 +1,175 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Decoder of symbols of explicit automata from symbolic assignments.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_SYMBOL_DECODER_HH_
+#define _VATA_EXPLICIT_SYMBOL_DECODER_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/explicit_tree_aut.hh>
+#include <vata/sym_var_asgn.hh>
+
+// standard library headers
+#include <cassert>
+#include <vector>
+
+
+// insert class to proper namespace
+namespace VATA { class ExplicitSymbolDecoder; }
+
+
+/**
+ * @brief  Inverse of an encoding of explicit symbols
+ *
+ * The encoded symbols are stored in a binary trie indexed by the variables of
+ * their assignments (a don't care variable of an encoded symbol is taken as
+ * zero, as by OndriksMTBDD::GetValue()). An assignment with don't care
+ * variables (e.g. a path of an MTBDD) is decoded by a single walk of the trie
+ * that branches on a don't care variable only if both of its values occur in
+ * the encoding.
+ */
+class VATA::ExplicitSymbolDecoder
+{
+public:   // data types
+
+	using ExplicitSymbol   = ExplicitTreeAut::SymbolType;
+	using EncodedSymbol    = SymbolicVarAsgn;
+
+private:  // data types
+
+	GCC_DIAG_OFF(effc++)
+	struct TrieNode
+	{
+	GCC_DIAG_ON(effc++)
+		size_t child[2];
+		std::vector<ExplicitSymbol> symbols;
+
+		TrieNode() :
+			child{NO_CHILD, NO_CHILD},
+			symbols()
+		{ }
+	};
+
+private:  // constants
+
+	static const size_t NO_CHILD = 0;
+
+private:  // data members
+
+	/**
+	 * @brief  Nodes of the trie, the root is the first one
+	 */
+	std::vector<TrieNode> nodes_;
+
+	/**
+	 * @brief  The number of variables of the encoded symbols
+	 */
+	size_t length_;
+
+private:  // methods
+
+	template <class Visitor>
+	void decode(
+		size_t                    node,
+		size_t                    var,
+		const SymbolicVarAsgn&    asgn,
+		Visitor&                  visitor) const
+	{
+		if (length_ == var)
+		{	// all variables have been read
+			for (const ExplicitSymbol& symbol : nodes_[node].symbols)
+			{
+				visitor(symbol);
+			}
+
+			return;
+		}
+
+		const char value = asgn.GetIthVariableValue(var);
+		for (size_t bit = 0; bit < 2; ++bit)
+		{
+			const char bitValue = (bit)? SymbolicVarAsgn::ONE : SymbolicVarAsgn::ZERO;
+			if ((SymbolicVarAsgn::DONT_CARE != value) && (bitValue != value))
+			{	// the variable has the other value
+				continue;
+			}
+
+			const size_t next = nodes_[node].child[bit];
+			if (NO_CHILD != next)
+			{	// in case some symbol is encoded with this value
+				decode(next, var + 1, asgn, visitor);
+			}
+		}
+	}
+
+public:   // methods
+
+	/**
+	 * @brief  Builds the decoder of an encoding
+	 *
+	 * @param[in]  encoding  Map from explicit symbols to their assignments (all
+	 *                       of the same length)
+	 */
+	template <class Encoding>
+	explicit ExplicitSymbolDecoder(const Encoding& encoding) :
+		nodes_(1),
+		length_(encoding.empty()? 0 : encoding.begin()->second.length())
+	{
+		for (const auto& symbolAsgnPair : encoding)
+		{
+			const EncodedSymbol& asgn = symbolAsgnPair.second;
+			assert(asgn.length() == length_);
+
+			size_t node = 0;
+			for (size_t var = 0; var < length_; ++var)
+			{
+				const size_t bit =
+					(SymbolicVarAsgn::ONE == asgn.GetIthVariableValue(var))? 1 : 0;
+
+				if (NO_CHILD == nodes_[node].child[bit])
+				{	// the root is never a child, so its index denotes no child
+					nodes_[node].child[bit] = nodes_.size();
+					nodes_.push_back(TrieNode());
+				}
+
+				node = nodes_[node].child[bit];
+			}
+
+			nodes_[node].symbols.push_back(symbolAsgnPair.first);
+		}
+	}
+
+	/**
+	 * @brief  The number of variables of the encoded symbols
+	 */
+	size_t GetSymbolLength() const
+	{
+		return length_;
+	}
+
+	/**
+	 * @brief  Calls @p visitor on every symbol matching an assignment
+	 *
+	 * @param[in]  asgn     The assignment (with at least GetSymbolLength()
+	 *                      variables, the other ones are ignored)
+	 * @param[in]  visitor  Functor called on every matching explicit symbol
+	 */
+	template <class Visitor>
+	void ForEachSymbol(
+		const SymbolicVarAsgn&    asgn,
+		Visitor                   visitor) const
+	{
+		assert(asgn.length() >= length_);
+
+		decode(0, 0, asgn, visitor);
+	}
+};
+
+#endif
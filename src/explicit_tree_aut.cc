@@ -11,11 +11,13 @@
 // VATA headers
 #include <vata/vata.hh>
 #include <vata/explicit_tree_aut.hh>
+#include <vata/context.hh>
 
 #include "explicit_tree_aut_core.hh"
 #include "loadable_aut.hh"
 
 using VATA::AutBase;
+using VATA::Context;
 using VATA::ExplicitTreeAut;
 using VATA::Util::AutDescription;
 
@@ -141,6 +143,13 @@ ExplicitTreeAut::ExplicitTreeAut(
 { }
 
 
+ExplicitTreeAut::ExplicitTreeAut(
+	Context&                     context) :
+	core_(new CoreAut(
+		context.GetExplicitTreeTupleCache(), context.GetExplicitTreeAlphabet()))
+{ }
+
+
 ExplicitTreeAut::ExplicitTreeAut(
 	const ExplicitTreeAut&         aut) :
 	core_(new CoreAut(*aut.core_))
@@ -421,6 +430,33 @@ bool ExplicitTreeAut::ContainsTransition(
 }
 
 
+bool ExplicitTreeAut::ContainsTransition(
+	const StateTuple&         children,
+	const SymbolType&         symbol,
+	const StateType&          state)
+{
+	assert(nullptr != core_);
+
+	return core_->ContainsTransition(children, symbol, state);
+}
+
+
+void ExplicitTreeAut::Freeze()
+{
+	assert(nullptr != core_);
+
+	core_->Freeze();
+}
+
+
+bool ExplicitTreeAut::IsFrozen() const
+{
+	assert(nullptr != core_);
+
+	return core_->IsFrozen();
+}
+
+
 void ExplicitTreeAut::LoadFromString(
 	VATA::Parsing::AbstrParser&       parser,
 	const std::string&                str,
@@ -635,6 +671,66 @@ ExplicitTreeAut ExplicitTreeAut::Intersection(
 }
 
 
+ExplicitTreeAut ExplicitTreeAut::Intersection(
+	const ExplicitTreeAut&            lhs,
+	const ExplicitTreeAut&            rhs,
+	AutBase::ProductTranslMap*        pTranslMap,
+	size_t                            threadCnt)
+{
+	assert(nullptr != lhs.core_);
+	assert(nullptr != rhs.core_);
+
+	return ExplicitTreeAut(
+		CoreAut::ParallelIntersection(*lhs.core_, *rhs.core_, threadCnt, pTranslMap));
+}
+
+
+bool ExplicitTreeAut::IsIntersectionEmpty(
+	const ExplicitTreeAut&            lhs,
+	const ExplicitTreeAut&            rhs,
+	ExplicitTreeAut*                  pWitness)
+{
+	std::vector<const ExplicitTreeAut*> auts;
+	auts.push_back(&lhs);
+	auts.push_back(&rhs);
+
+	return ExplicitTreeAut::IsIntersectionEmpty(auts, pWitness);
+}
+
+
+bool ExplicitTreeAut::IsIntersectionEmpty(
+	const std::vector<const ExplicitTreeAut*>&   auts,
+	ExplicitTreeAut*                             pWitness)
+{
+	std::vector<const ExplicitTreeAutCore*> coreAuts;
+	for (const ExplicitTreeAut* aut : auts)
+	{
+		assert(nullptr != aut);
+		assert(nullptr != aut->core_);
+
+		coreAuts.push_back(aut->core_.get());
+	}
+
+	if (nullptr == pWitness)
+	{
+		return CoreAut::IsIntersectionEmpty(coreAuts);
+	}
+
+	// the witness lives in the environment (tuple cache and alphabet) of the
+	// intersected automata
+	assert(!coreAuts.empty());
+	CoreAut witness(*coreAuts.front(), false, false);
+	if (CoreAut::IsIntersectionEmpty(coreAuts, &witness))
+	{
+		return true;
+	}
+
+	*pWitness = ExplicitTreeAut(std::move(witness));
+
+	return false;
+}
+
+
 AutBase::StateBinaryRelation ExplicitTreeAut::ComputeSimulation(
 	const VATA::SimParam&                  params) const
 {
@@ -206,6 +206,8 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(tupleCache),
 	finalStates_(),
 	transitions_(StateToTransitionClusterMapPtr(new StateToTransitionClusterMap())),
+	frozen_(),
+	bottomUpIndex_(),
 	alphabet_(alphabet)
 { }
 
@@ -217,11 +219,15 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(aut.cache_),
 	finalStates_(),
 	transitions_(),
+	frozen_(),
+	bottomUpIndex_(),
 	alphabet_(aut.alphabet_)
 {
 	if (copyTrans)
 	{
 		transitions_ = aut.transitions_;
+		frozen_      = aut.frozen_;
+		bottomUpIndex_ = aut.bottomUpIndex_;
 	}
 	else
 	{
@@ -240,6 +246,8 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(aut.cache_),
 	finalStates_(std::move(aut.finalStates_)),
 	transitions_(std::move(aut.transitions_)),
+	frozen_(std::move(aut.frozen_)),
+	bottomUpIndex_(std::move(aut.bottomUpIndex_)),
 	alphabet_(std::move(aut.alphabet_))
 { }
 
@@ -250,6 +258,8 @@ ExplicitTreeAutCore::ExplicitTreeAutCore(
 	cache_(tupleCache),
 	finalStates_(aut.finalStates_),
 	transitions_(aut.transitions_),
+	frozen_(aut.frozen_),
+	bottomUpIndex_(aut.bottomUpIndex_),
 	alphabet_(aut.alphabet_)
 { }
 
@@ -261,6 +271,8 @@ ExplicitTreeAutCore& ExplicitTreeAutCore::operator=(
 	{
 		finalStates_ = rhs.finalStates_;
 		transitions_ = rhs.transitions_;
+		frozen_      = rhs.frozen_;
+		bottomUpIndex_ = rhs.bottomUpIndex_;
 		alphabet_    = rhs.alphabet_;
 		// NOTE: we don't care about cache_
 	}
@@ -276,6 +288,8 @@ ExplicitTreeAutCore& ExplicitTreeAutCore::operator=(
 
 	finalStates_ = std::move(rhs.finalStates_);
 	transitions_ = std::move(rhs.transitions_);
+	frozen_      = std::move(rhs.frozen_);
+	bottomUpIndex_ = std::move(rhs.bottomUpIndex_);
 	alphabet_    = std::move(rhs.alphabet_);
 	// NOTE: we don't care about cache_
 
@@ -318,7 +332,8 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Reduce() const
 
 
 AutBase::StateBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
-	size_t             size) const
+	size_t             size,
+	size_t             threadCnt) const
 {
 	std::vector<std::vector<size_t>> partition;
 
@@ -326,7 +341,7 @@ AutBase::StateBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
 
 	return this->TranslateUpward(
 		partition, relation, Util::Identity(size)
-	).computeSimulation(partition, relation, size);
+	).computeSimulation(partition, relation, size, threadCnt);
 }
 
 
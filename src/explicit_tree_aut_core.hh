@@ -44,6 +44,7 @@ namespace VATA
 		using StateType        = ExplicitTreeAut::StateType;
 		using FinalStateSet    = ExplicitTreeAut::FinalStateSet;
 		using SymbolType       = ExplicitTreeAut::SymbolType;
+		using StateTuple       = ExplicitTreeAut::StateTuple;
 		using TuplePtr         = std::shared_ptr<ExplicitTreeAut::StateTuple>;
 		using TuplePtrSet      = std::set<TuplePtr>;
 		using TuplePtrSetPtr   = std::shared_ptr<TuplePtrSet>;
@@ -114,6 +115,14 @@ namespace VATA
 
 		class AcceptTrans;
 		class DownAccessor;
+
+		class FrozenTransitions;
+
+		using FrozenTransitionsPtr    = std::shared_ptr<const FrozenTransitions>;
+
+		class BottomUpIndex;
+
+		using BottomUpIndexPtr        = std::shared_ptr<const BottomUpIndex>;
 	}
 }
 
@@ -431,6 +440,13 @@ private:  // data types
 	using StateToTransitionClusterMap    = ExplicitTreeAutCoreUtil::StateToTransitionClusterMap;
 	using StateToTransitionClusterMapPtr = std::shared_ptr<StateToTransitionClusterMap>;
 
+public:   // data types
+
+	using FrozenTransitions              = ExplicitTreeAutCoreUtil::FrozenTransitions;
+	using FrozenTransitionsPtr           = ExplicitTreeAutCoreUtil::FrozenTransitionsPtr;
+	using BottomUpIndex                  = ExplicitTreeAutCoreUtil::BottomUpIndex;
+	using BottomUpIndexPtr               = ExplicitTreeAutCoreUtil::BottomUpIndexPtr;
+
 
 private:  // data members
 
@@ -440,6 +456,22 @@ private:  // data members
 
 	StateToTransitionClusterMapPtr transitions_;
 
+	/**
+	 * @brief  The frozen (CSR) copy of the transitions
+	 *
+	 * Set by Freeze(), @p nullptr otherwise. It is shared by copies of the
+	 * automaton and dropped whenever the transitions are modified.
+	 */
+	FrozenTransitionsPtr frozen_;
+
+	/**
+	 * @brief  The bottom-up index of the transitions
+	 *
+	 * Built lazily by GetBottomUpIndex() and dropped whenever the transitions
+	 * are modified. It is declared as mutable because it is only a cache.
+	 */
+	mutable BottomUpIndexPtr bottomUpIndex_;
+
 	/**
 	 * @brief  The alphabet of the automaton
 	 *
@@ -480,6 +512,10 @@ private:  // methods
 	{
 		assert(nullptr != transitions_);
 
+		// the transitions are going to be modified
+		frozen_ = nullptr;
+		bottomUpIndex_ = nullptr;
+
 		if (!transitions_.unique())
 		{
 			transitions_ = StateToTransitionClusterMapPtr(
@@ -492,6 +528,22 @@ private:  // methods
 	}
 
 
+	bool containsFrozenTransition(
+		const StateTuple&         children,
+		const SymbolType&         symbol,
+		const StateType&          parent) const;
+
+
+	static ExplicitTreeAutCore intersectionFrozen(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		VATA::AutBase::ProductTranslMap*     pTranslMap);
+
+
+	ExplicitTreeAutCore removeUselessStatesFrozen(
+		StateToStateMap*            pTranslMap) const;
+
+
 	void internalAddTransition(
 		const TuplePtr&           children,
 		const SymbolType&         symbol,
@@ -615,6 +667,44 @@ public:   // methods
 	}
 
 
+	/**
+	 * @brief  Compacts the transitions into a read-only CSR layout
+	 *
+	 * Builds the frozen copy of the transition table, which is then used by
+	 * read-only operations (such as Intersection() or RemoveUselessStates())
+	 * instead of the hash-based table. Any later modification of the
+	 * transitions drops the frozen copy, so the automaton remains fully
+	 * usable; call Freeze() again after the modifications are done.
+	 */
+	void Freeze();
+
+	bool IsFrozen() const
+	{
+		return nullptr != frozen_;
+	}
+
+	/**
+	 * @brief  Retrieves the frozen transition table
+	 *
+	 * @returns  The frozen transition table or @p nullptr in the case the
+	 *           automaton is not frozen
+	 */
+	const FrozenTransitions* GetFrozenTransitions() const
+	{
+		return frozen_.get();
+	}
+
+	/**
+	 * @brief  Retrieves the bottom-up index of the transitions
+	 *
+	 * The index is built on the first call and cached until the transitions
+	 * are modified. Building it is not synchronised, so the first call must
+	 * not race with other calls on the same automaton.
+	 *
+	 * @returns  The bottom-up index
+	 */
+	const BottomUpIndex& GetBottomUpIndex() const;
+
 	bool ContainsTransition(
 		const StateTuple&         children,
 		const SymbolType&         symbol,
@@ -622,6 +712,11 @@ public:   // methods
 	{
 		assert(nullptr != transitions_);
 
+		if (nullptr != frozen_)
+		{
+			return this->containsFrozenTransition(children, symbol, parent);
+		}
+
 		auto itStateToClusterMap = transitions_->find(parent);
 		if (transitions_->end() != itStateToClusterMap)
 		{
@@ -634,7 +729,10 @@ public:   // methods
 				assert(nullptr != itSymbolToTuplePtrSet->second);
 				const TuplePtrSet& tuplePtrSet = *itSymbolToTuplePtrSet->second;
 
-				return (tuplePtrSet.end() != tuplePtrSet.find(this->tupleLookup(children)));
+				// do not intern tuples just for the query
+				TuplePtr tuple = cache_.find(children);
+
+				return (nullptr != tuple) && (tuplePtrSet.end() != tuplePtrSet.find(tuple));
 			}
 		}
 
@@ -795,6 +893,11 @@ public:   // methods
 
 		auto clusterMap = dst.uniqueClusterMap();
 
+		// a tuple typically occurs in many transitions, so it is translated only
+		// once
+		std::unordered_map<const StateTuple*, TuplePtr> tupleTransl;
+		StateTuple newTuple;
+
 		for (auto& stateClusterPair : *transitions_)
 		{
 			assert(stateClusterPair.second);
@@ -811,14 +914,22 @@ public:   // methods
 				{
 					assert(tuple);
 
-					StateTuple newTuple;
+					auto itTransl = tupleTransl.insert(
+						std::make_pair(tuple.get(), TuplePtr(nullptr))).first;
 
-					for (const StateType& s : *tuple)
+					if (nullptr == itTransl->second)
 					{
-						newTuple.push_back(index[s]);
+						newTuple.clear();
+
+						for (const StateType& s : *tuple)
+						{
+							newTuple.push_back(index[s]);
+						}
+
+						itTransl->second = dst.tupleLookup(newTuple);
 					}
 
-					tuplePtrSet->insert(dst.tupleLookup(newTuple));
+					tuplePtrSet->insert(itTransl->second);
 				}
 			}
 		}
@@ -830,7 +941,7 @@ public:   // methods
 		Index&                    index,
 		bool                      addFinalStates = true) const
 	{
-		ExplicitTreeAutCore res;
+		ExplicitTreeAutCore res(cache_, alphabet_);
 		this->ReindexStates(res, index, addFinalStates);
 
 		return res;
@@ -974,7 +1085,7 @@ public:   // methods
 		Util::RebindMap2(transl, representatives, bwIndex);
 
 		// TODO: directly return the output of ReindexStates?
-		ExplicitTreeAutCore res(cache_);
+		ExplicitTreeAutCore res(cache_, alphabet_);
 
 		this->ReindexStates(res, transl);
 
@@ -990,7 +1101,8 @@ public:   // methods
 		const Index&      index) const;
 
 	AutBase::StateBinaryRelation ComputeDownwardSimulation(
-		size_t            size) const;
+		size_t            size,
+		size_t            threadCnt = 1) const;
 
 
 	template <class Index>
@@ -1009,7 +1121,8 @@ public:   // methods
 
 
 	AutBase::StateBinaryRelation ComputeUpwardSimulation(
-		size_t             size) const;
+		size_t             size,
+		size_t             threadCnt = 1) const;
 
 
 	AutBase::StateBinaryRelation ComputeUpwardSimulation(
@@ -1037,6 +1150,51 @@ public:   // methods
 		const ExplicitTreeAutCore&           rhs,
 		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
 
+
+	/**
+	 * @brief  Checks whether the intersection of languages is empty
+	 *
+	 * The check runs a bottom-up saturation over tuples of states of the
+	 * automata without building the product automaton, and stops as soon as
+	 * a tuple of accepting states is reached.
+	 *
+	 * @param[in]   auts      The automata (at least one)
+	 * @param[out]  pWitness  If not @p nullptr and the intersection is not
+	 *                        empty, set to an automaton accepting a single tree
+	 *                        from the intersection
+	 *
+	 * @returns  @p true in case the intersection of languages of @p auts is
+	 *           empty, @p false otherwise
+	 */
+	static bool IsIntersectionEmpty(
+		const std::vector<const ExplicitTreeAutCore*>&   auts,
+		ExplicitTreeAutCore*                             pWitness = nullptr);
+
+	static bool IsIntersectionEmpty(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		ExplicitTreeAutCore*                 pWitness = nullptr);
+
+
+	/**
+	 * @brief  Intersection computed by several threads
+	 *
+	 * Product states are explored by @p threadCnt threads with work-stealing
+	 * queues. The result is the same as the one of Intersection() up to
+	 * renaming of the product states.
+	 *
+	 * @param[in]   lhs        Left automaton
+	 * @param[in]   rhs        Right automaton
+	 * @param[in]   threadCnt  The number of threads (0 for the number of cores)
+	 * @param[out]  pTranslMap Mapping of pairs of states to product states
+	 */
+	static ExplicitTreeAutCore ParallelIntersection(
+		const ExplicitTreeAutCore&           lhs,
+		const ExplicitTreeAutCore&           rhs,
+		size_t                               threadCnt,
+		VATA::AutBase::ProductTranslMap*     pTranslMap = nullptr);
+
+
 	ExplicitTreeAutCore GetCandidateTree() const;
 
 
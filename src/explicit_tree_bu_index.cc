@@ -0,0 +1,75 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the bottom-up index of the transitions of an
+ *    explicitly represented tree automaton.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_bu_index.hh"
+
+
+using VATA::ExplicitTreeAutCore;
+using VATA::ExplicitTreeAutCoreUtil::BottomUpIndex;
+using VATA::ExplicitTreeAutCoreUtil::StateToTransitionClusterMap;
+
+
+BottomUpIndex::BottomUpIndex(
+	const StateToTransitionClusterMap&     transitions) :
+	transitions_(),
+	leafTransitions_(),
+	up_(),
+	leaves_(),
+	emptyList_()
+{
+	for (auto& stateClusterPair : transitions)
+	{
+		assert(nullptr != stateClusterPair.second);
+
+		for (auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(nullptr != symbolTupleSetPair.second);
+
+			for (auto& tuple : *symbolTupleSetPair.second)
+			{
+				assert(nullptr != tuple);
+
+				if (tuple->empty())
+				{
+					leaves_[symbolTupleSetPair.first].push_back(stateClusterPair.first);
+					leafTransitions_.push_back(Transition(
+						tuple, symbolTupleSetPair.first, stateClusterPair.first));
+					continue;
+				}
+
+				for (size_t i = 0; i < tuple->size(); ++i)
+				{
+					up_[(*tuple)[i]].push_back(Occurrence(transitions_.size(), i));
+				}
+
+				transitions_.push_back(Transition(
+					tuple, symbolTupleSetPair.first, stateClusterPair.first));
+			}
+		}
+	}
+}
+
+
+const BottomUpIndex& ExplicitTreeAutCore::GetBottomUpIndex() const
+{
+	if (nullptr == bottomUpIndex_)
+	{
+		assert(nullptr != transitions_);
+
+		bottomUpIndex_ = BottomUpIndexPtr(new BottomUpIndex(*transitions_));
+	}
+
+	return *bottomUpIndex_;
+}
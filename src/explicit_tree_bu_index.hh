@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Header file for the bottom-up index of the transitions of an explicitly
+ *    represented tree automaton.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_BU_INDEX_HH_
+#define _VATA_EXPLICIT_TREE_BU_INDEX_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+
+
+/**
+ * @brief  Bottom-up index of the transitions of an explicit tree automaton
+ *
+ * The index maps every state to the list of its occurrences in the left-hand
+ * sides of transitions, i.e., to pairs (transition, position), and every
+ * symbol to the parents of the nullary transitions over the symbol. The
+ * transitions are numbered densely from 0, so algorithms can keep their
+ * per-transition data in plain arrays.
+ *
+ * The index is built lazily by ExplicitTreeAutCore::GetBottomUpIndex() and is
+ * dropped on any modification of the transitions of the automaton.
+ */
+class VATA::ExplicitTreeAutCoreUtil::BottomUpIndex
+{
+public:   // data types
+
+	struct Transition
+	{
+		TuplePtr children;
+		SymbolType symbol;
+		StateType parent;
+
+		Transition(
+			const TuplePtr&        children,
+			const SymbolType&      symbol,
+			const StateType&       parent) :
+			children(children),
+			symbol(symbol),
+			parent(parent)
+		{ }
+	};
+
+	/**
+	 * @brief  Occurrence of a state in a transition (index, position)
+	 */
+	using Occurrence       = std::pair<size_t, size_t>;
+	using OccurrenceList   = std::vector<Occurrence>;
+	using StateList        = std::vector<StateType>;
+	using SymbolToStatesMap = std::unordered_map<SymbolType, StateList>;
+
+private:  // data members
+
+	std::vector<Transition> transitions_;
+
+	std::vector<Transition> leafTransitions_;
+
+	std::unordered_map<StateType, OccurrenceList> up_;
+
+	SymbolToStatesMap leaves_;
+
+	const OccurrenceList emptyList_;
+
+private:  // methods
+
+	BottomUpIndex(const BottomUpIndex&);
+	BottomUpIndex& operator=(const BottomUpIndex&);
+
+public:   // methods
+
+	/**
+	 * @brief  Indexes the transitions of an automaton
+	 *
+	 * @param[in]  transitions  The transition table to be indexed
+	 */
+	explicit BottomUpIndex(
+		const StateToTransitionClusterMap&     transitions);
+
+	/**
+	 * @brief  The number of transitions with a nonempty left-hand side
+	 */
+	size_t TransitionCount() const
+	{
+		return transitions_.size();
+	}
+
+	const Transition& GetTransition(size_t index) const
+	{
+		assert(index < transitions_.size());
+
+		return transitions_[index];
+	}
+
+	const OccurrenceList& GetOccurrences(const StateType& state) const
+	{
+		auto it = up_.find(state);
+
+		return (up_.end() == it)? emptyList_ : it->second;
+	}
+
+	/**
+	 * @brief  The nullary transitions
+	 */
+	const std::vector<Transition>& GetLeafTransitions() const
+	{
+		return leafTransitions_;
+	}
+
+	/**
+	 * @brief  Parents of nullary transitions, indexed by symbols
+	 */
+	const SymbolToStatesMap& GetLeaves() const
+	{
+		return leaves_;
+	}
+};
+
+#endif
@@ -17,126 +17,67 @@
 #include <vata/vata.hh>
 
 #include "explicit_tree_aut_core.hh"
+#include "explicit_tree_bu_index.hh"
 
 using VATA::ExplicitTreeAutCore;
 
 ExplicitTreeAutCore ExplicitTreeAutCore::GetCandidateTree() const
 {
-	struct TransitionInfo
-	{
-		TuplePtr children_;
-		SymbolType symbol_;
-		StateType state_;
-
-		std::set<StateType> childrenSet_;
-
-		TransitionInfo(
-			const TuplePtr&      children,
-			const SymbolType&    symbol,
-			const StateType&     state) :
-			children_(children),
-			symbol_(symbol),
-			state_(state),
-			childrenSet_(children->begin(), children->end())
-		{ }
-
-		bool reachedBy(const StateType& state)
-		{
-			assert(childrenSet_.count(state));
+	const BottomUpIndex& index = this->GetBottomUpIndex();
 
-			childrenSet_.erase(state);
-
-			return childrenSet_.empty();
-		}
-	};
-
-	typedef std::shared_ptr<TransitionInfo> TransitionInfoPtr;
+	// the number of children of every transition not yet reached
+	std::vector<size_t> pending(index.TransitionCount());
+	for (size_t i = 0; i < pending.size(); ++i)
+	{
+		pending[i] = index.GetTransition(i).children->size();
+	}
 
-	std::unordered_map<StateType, std::vector<TransitionInfoPtr>> stateMap;
 	std::unordered_set<StateType> reachableStates;
-	std::vector<TransitionInfoPtr> reachableTransitions;
+	std::vector<const BottomUpIndex::Transition*> reachableTransitions;
 	std::list<StateType> newStates;
 
-	assert(nullptr != transitions_);
+	size_t remaining = index.TransitionCount();
 
-	size_t remaining = 0;
-
-	// Cycle builds information structure about transitions and also
-	// saves the reachable transitions (start states)
-	for (auto& stateClusterPair : *transitions_)
+	// the nullary transitions are reachable (start states)
+	for (auto& trans : index.GetLeafTransitions())
 	{
-		assert(stateClusterPair.second);
+		reachableTransitions.push_back(&trans);
 
-		for (auto& symbolTupleSetPair : *stateClusterPair.second)
+		if (reachableStates.insert(trans.parent).second)
 		{
-			assert(symbolTupleSetPair.second);
-
-			for (auto& tuple : *symbolTupleSetPair.second)
-			{
-				assert(tuple);
-
-				auto transitionInfoPtr = TransitionInfoPtr(
-					new TransitionInfo(tuple, symbolTupleSetPair.first, stateClusterPair.first)
-				);
-
-				if (tuple->empty())
-				{
-					reachableTransitions.push_back(transitionInfoPtr);
-
-					if (reachableStates.insert(stateClusterPair.first).second)
-					{
-						newStates.push_back(stateClusterPair.first);
-					}
-
-					continue;
-				}
-
-				for (auto& s : transitionInfoPtr->childrenSet_)
-				{
-					// Add a new pair to stateMap and also add the transitionInfor
-					// ptr to the second item of the pair in one step
-					stateMap.insert(
-						std::make_pair(s, std::vector<TransitionInfoPtr>())
-					).first->second.push_back(transitionInfoPtr);
-
-					++remaining;
-				}
-			}
+			newStates.push_back(trans.parent);
 		}
 	}
 
 	while (!newStates.empty())
 	{
-		// find transition which leads from the chosen state from newStates
-		auto i = stateMap.find(newStates.front());
+		// find transitions which lead from the chosen state from newStates
+		const StateType state = newStates.front();
 
 		newStates.pop_front();
 
-		if (i == stateMap.end())
-		{
-			continue;
-		}
-
 		// iterate through all transitions
-		for (auto& info : i->second)
+		for (auto& occ : index.GetOccurrences(state))
 		{
-			assert(info);
+			assert(pending[occ.first] > 0);
 
 			// All states of tuple of transition was used
-			if (!info->reachedBy(i->first))
+			if (--pending[occ.first])
 			{
 				continue;
 			}
 
 			--remaining;
 
+			const BottomUpIndex::Transition& trans = index.GetTransition(occ.first);
+
 			// Insert state, which is accessible from currently chosen transition
-			if (reachableStates.insert(info->state_).second)
+			if (reachableStates.insert(trans.parent).second)
 			{
-				reachableTransitions.push_back(info);
+				reachableTransitions.push_back(&trans);
 
-				newStates.push_back(info->state_);
-				if (this->IsStateFinal(info->state_))
+				newStates.push_back(trans.parent);
+				if (this->IsStateFinal(trans.parent))
 				{
 					goto found_;
 				}
@@ -146,7 +87,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::GetCandidateTree() const
 
 found_:
 
-	ExplicitTreeAutCore result(cache_);
+	ExplicitTreeAutCore result(cache_, alphabet_);
 
 	for (const StateType& state : finalStates_)
 	{
@@ -159,15 +100,16 @@ found_:
 	if (!remaining)
 	{
 		result.transitions_ = transitions_;
+		result.bottomUpIndex_ = bottomUpIndex_;
 
 		return result.RemoveUnreachableStates();
 	}
 
-	for (auto& info : reachableTransitions)
+	for (auto& trans : reachableTransitions)
 	{
-		assert(info);
+		assert(nullptr != trans);
 
-		result.internalAddTransition(info->children_, info->symbol_, info->state_);
+		result.internalAddTransition(trans->children, trans->symbol, trans->parent);
 	}
 
 	return result.RemoveUnreachableStates();
@@ -358,7 +358,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::ComplementWithPreorder(
 	const Dict&                            alphabet,
 	const Rel&                             preorder) const
 {
-	ExplicitTreeAutCore res;
+	ExplicitTreeAutCore res(cache_, alphabet_);
 
 	VATA::ExplicitDownwardComplementation::Compute(res, *this, alphabet, preorder);
 
@@ -0,0 +1,197 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of the frozen transition table of an explicitly
+ *    represented tree automaton.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_frozen.hh"
+
+
+using VATA::ExplicitTreeAutCore;
+using VATA::ExplicitTreeAutCoreUtil::FrozenTransitions;
+using VATA::ExplicitTreeAutCoreUtil::StateToTransitionClusterMap;
+using VATA::ExplicitTreeAutCoreUtil::StateType;
+using VATA::ExplicitTreeAutCoreUtil::SymbolType;
+
+
+FrozenTransitions::FrozenTransitions(
+	const StateToTransitionClusterMap&     transitions) :
+	parents_(),
+	parentOffsets_(),
+	symbols_(),
+	symbolOffsets_(),
+	tupleIds_(),
+	tupleOffsets_(),
+	tupleStates_()
+{
+	// collect distinct tuple pointers
+	std::unordered_map<const StateTuple*, TupleIdType> tupleMap;
+	std::vector<const StateTuple*> tuples;
+
+	size_t transCnt = 0;
+	size_t symbolCnt = 0;
+	for (auto& stateClusterPair : transitions)
+	{
+		assert(nullptr != stateClusterPair.second);
+
+		parents_.push_back(stateClusterPair.first);
+		symbolCnt += stateClusterPair.second->size();
+
+		for (auto& symbolTupleSetPair : *stateClusterPair.second)
+		{
+			assert(nullptr != symbolTupleSetPair.second);
+
+			transCnt += symbolTupleSetPair.second->size();
+
+			for (auto& tuple : *symbolTupleSetPair.second)
+			{
+				assert(nullptr != tuple);
+
+				if (tupleMap.insert(std::make_pair(tuple.get(), 0)).second)
+				{
+					tuples.push_back(tuple.get());
+				}
+			}
+		}
+	}
+
+	// assign IDs in the lexicographic order of tuples so that sorting by IDs
+	// is the same as sorting by the content; tuples coming from different
+	// caches may be equal even though their pointers differ, these get the
+	// same ID
+	std::sort(tuples.begin(), tuples.end(),
+		[](const StateTuple* lhs, const StateTuple* rhs){ return *lhs < *rhs; });
+
+	tupleOffsets_.reserve(tuples.size() + 1);
+	tupleOffsets_.push_back(0);
+	for (size_t i = 0; i < tuples.size(); ++i)
+	{
+		if ((0 == i) || (*tuples[i - 1] != *tuples[i]))
+		{
+			tupleStates_.insert(tupleStates_.end(), tuples[i]->begin(), tuples[i]->end());
+			tupleOffsets_.push_back(static_cast<IndexType>(tupleStates_.size()));
+		}
+
+		tupleMap[tuples[i]] = static_cast<TupleIdType>(tupleOffsets_.size() - 2);
+	}
+
+	std::sort(parents_.begin(), parents_.end());
+
+	parentOffsets_.reserve(parents_.size() + 1);
+	symbols_.reserve(symbolCnt);
+	symbolOffsets_.reserve(symbolCnt + 1);
+	tupleIds_.reserve(transCnt);
+
+	parentOffsets_.push_back(0);
+	symbolOffsets_.push_back(0);
+
+	std::vector<SymbolType> clusterSymbols;
+	for (const StateType& parent : parents_)
+	{
+		const TransitionCluster& cluster = *transitions.find(parent)->second;
+
+		clusterSymbols.clear();
+		for (auto& symbolTupleSetPair : cluster)
+		{
+			clusterSymbols.push_back(symbolTupleSetPair.first);
+		}
+
+		std::sort(clusterSymbols.begin(), clusterSymbols.end());
+
+		for (const SymbolType& symbol : clusterSymbols)
+		{
+			symbols_.push_back(symbol);
+
+			size_t begin = tupleIds_.size();
+			for (auto& tuple : *cluster.find(symbol)->second)
+			{
+				tupleIds_.push_back(tupleMap[tuple.get()]);
+			}
+
+			std::sort(tupleIds_.begin() + begin, tupleIds_.end());
+			tupleIds_.erase(
+				std::unique(tupleIds_.begin() + begin, tupleIds_.end()), tupleIds_.end());
+
+			symbolOffsets_.push_back(static_cast<IndexType>(tupleIds_.size()));
+		}
+
+		parentOffsets_.push_back(static_cast<IndexType>(symbols_.size()));
+	}
+}
+
+
+bool FrozenTransitions::ContainsTransition(
+	const StateTuple&          children,
+	const SymbolType&          symbol,
+	const StateType&           parent) const
+{
+	IndexType parentIndex = this->FindParent(parent);
+	if (NotFound == parentIndex)
+	{
+		return false;
+	}
+
+	IndexType symbolIndex = this->FindSymbol(parentIndex, symbol);
+	if (NotFound == symbolIndex)
+	{
+		return false;
+	}
+
+	auto begin = tupleIds_.begin() + this->TupleBegin(symbolIndex);
+	auto end = tupleIds_.begin() + this->TupleEnd(symbolIndex);
+
+	auto it = std::lower_bound(begin, end, children,
+		[this](const TupleIdType& tupleId, const StateTuple& tuple)
+		{
+			const StateType* data = this->TupleData(tupleId);
+
+			return std::lexicographical_compare(
+				data, data + this->TupleSize(tupleId), tuple.begin(), tuple.end());
+		});
+
+	if (end == it)
+	{
+		return false;
+	}
+
+	const StateType* data = this->TupleData(*it);
+
+	return (this->TupleSize(*it) == children.size()) &&
+		std::equal(children.begin(), children.end(), data);
+}
+
+
+void ExplicitTreeAutCore::Freeze()
+{
+	assert(nullptr != transitions_);
+
+	if (nullptr == frozen_)
+	{
+		frozen_ = FrozenTransitionsPtr(new FrozenTransitions(*transitions_));
+	}
+}
+
+
+bool ExplicitTreeAutCore::containsFrozenTransition(
+	const StateTuple&         children,
+	const SymbolType&         symbol,
+	const StateType&          parent) const
+{
+	assert(nullptr != frozen_);
+
+	return frozen_->ContainsTransition(children, symbol, parent);
+}
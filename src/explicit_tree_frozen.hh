@@ -0,0 +1,215 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Header file for the frozen (read-only, compact) transition table of an
+ *    explicitly represented tree automaton.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_EXPLICIT_TREE_FROZEN_HH_
+#define _VATA_EXPLICIT_TREE_FROZEN_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+
+
+/**
+ * @brief  Frozen transition table of an explicit tree automaton
+ *
+ * This is a read-only snapshot of the transitions of an ExplicitTreeAutCore
+ * stored in the compressed sparse row (CSR) format. The table is a three-level
+ * structure where every level is a contiguous array:
+ *
+ * @li  parent states (sorted) with offsets into the symbol array,
+ * @li  symbols (sorted for every parent) with offsets into the tuple-ID array,
+ * @li  tuple IDs (sorted for every symbol) referring to the tuple pool.
+ *
+ * The tuple pool stores every distinct tuple exactly once, the states of all
+ * tuples are kept in a single array. Tuple IDs are dense 32-bit numbers, so
+ * they can be used to index auxiliary arrays of the algorithms.
+ *
+ * The table is built by ExplicitTreeAutCore::Freeze() and is dropped on any
+ * modification of the transitions of the automaton.
+ */
+class VATA::ExplicitTreeAutCoreUtil::FrozenTransitions
+{
+public:   // data types
+
+	using IndexType        = uint32_t;
+	using TupleIdType      = uint32_t;
+
+	/**
+	 * @brief  Value returned by lookups that fail
+	 */
+	static const IndexType NotFound = static_cast<IndexType>(-1);
+
+private:  // data members
+
+	std::vector<StateType> parents_;
+	std::vector<IndexType> parentOffsets_;
+
+	std::vector<SymbolType> symbols_;
+	std::vector<IndexType> symbolOffsets_;
+
+	std::vector<TupleIdType> tupleIds_;
+
+	std::vector<IndexType> tupleOffsets_;
+	std::vector<StateType> tupleStates_;
+
+public:   // methods
+
+	/**
+	 * @brief  Compacts the transitions of an automaton
+	 *
+	 * @param[in]  transitions  The transition table to be frozen
+	 */
+	explicit FrozenTransitions(
+		const StateToTransitionClusterMap&     transitions);
+
+	size_t ParentCount() const
+	{
+		return parents_.size();
+	}
+
+	size_t TupleCount() const
+	{
+		assert(!tupleOffsets_.empty());
+
+		return tupleOffsets_.size() - 1;
+	}
+
+	size_t TransitionCount() const
+	{
+		return tupleIds_.size();
+	}
+
+	const StateType& GetParent(IndexType parentIndex) const
+	{
+		assert(parentIndex < parents_.size());
+
+		return parents_[parentIndex];
+	}
+
+	/**
+	 * @brief  Finds the index of a parent state
+	 *
+	 * @param[in]  state  The parent state
+	 *
+	 * @returns  Index of @p state in the parent array, or @p NotFound in case
+	 *           there is no transition going down from @p state
+	 */
+	IndexType FindParent(const StateType& state) const
+	{
+		auto it = std::lower_bound(parents_.begin(), parents_.end(), state);
+		if ((parents_.end() == it) || (*it != state))
+		{
+			return NotFound;
+		}
+
+		return static_cast<IndexType>(it - parents_.begin());
+	}
+
+	IndexType SymbolBegin(IndexType parentIndex) const
+	{
+		assert(parentIndex < parents_.size());
+
+		return parentOffsets_[parentIndex];
+	}
+
+	IndexType SymbolEnd(IndexType parentIndex) const
+	{
+		assert(parentIndex < parents_.size());
+
+		return parentOffsets_[parentIndex + 1];
+	}
+
+	const SymbolType& GetSymbol(IndexType symbolIndex) const
+	{
+		assert(symbolIndex < symbols_.size());
+
+		return symbols_[symbolIndex];
+	}
+
+	/**
+	 * @brief  Finds a symbol among the symbols of a parent
+	 *
+	 * @param[in]  parentIndex  Index of the parent state
+	 * @param[in]  symbol       The symbol
+	 *
+	 * @returns  Index of @p symbol in the symbol array, or @p NotFound
+	 */
+	IndexType FindSymbol(
+		IndexType                  parentIndex,
+		const SymbolType&          symbol) const
+	{
+		auto begin = symbols_.begin() + this->SymbolBegin(parentIndex);
+		auto end = symbols_.begin() + this->SymbolEnd(parentIndex);
+
+		auto it = std::lower_bound(begin, end, symbol);
+		if ((end == it) || (*it != symbol))
+		{
+			return NotFound;
+		}
+
+		return static_cast<IndexType>(it - symbols_.begin());
+	}
+
+	IndexType TupleBegin(IndexType symbolIndex) const
+	{
+		assert(symbolIndex < symbols_.size());
+
+		return symbolOffsets_[symbolIndex];
+	}
+
+	IndexType TupleEnd(IndexType symbolIndex) const
+	{
+		assert(symbolIndex < symbols_.size());
+
+		return symbolOffsets_[symbolIndex + 1];
+	}
+
+	const TupleIdType& GetTupleId(IndexType tupleIndex) const
+	{
+		assert(tupleIndex < tupleIds_.size());
+
+		return tupleIds_[tupleIndex];
+	}
+
+	size_t TupleSize(TupleIdType tupleId) const
+	{
+		assert(tupleId + 1U < tupleOffsets_.size());
+
+		return tupleOffsets_[tupleId + 1] - tupleOffsets_[tupleId];
+	}
+
+	/**
+	 * @brief  Retrieves the states of a tuple from the pool
+	 *
+	 * @param[in]  tupleId  ID of the tuple
+	 *
+	 * @returns  Pointer to the first of TupleSize(@p tupleId) states
+	 */
+	const StateType* TupleData(TupleIdType tupleId) const
+	{
+		assert(tupleId + 1U < tupleOffsets_.size());
+
+		return tupleStates_.data() + tupleOffsets_[tupleId];
+	}
+
+	bool ContainsTransition(
+		const StateTuple&          children,
+		const SymbolType&          symbol,
+		const StateType&           parent) const;
+};
+
+#endif
@@ -26,8 +26,10 @@ bool ExplicitTreeAutCore::CheckInclusion(
 	const ExplicitTreeAutCore&             bigger,
 	const VATA::InclParam&                 params)
 {
-	ExplicitTreeAutCore newSmaller;
-	ExplicitTreeAutCore newBigger;
+	// the working copies need to stay in the environment (tuple cache and
+	// alphabet) of the operands, which may belong to a Context
+	ExplicitTreeAutCore newSmaller(smaller.cache_, smaller.alphabet_);
+	ExplicitTreeAutCore newBigger(bigger.cache_, bigger.alphabet_);
 	typename AutBase::StateType states = static_cast<typename AutBase::StateType>(-1);
 
 	if (!params.GetUseSimulation())
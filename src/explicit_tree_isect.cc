@@ -12,10 +12,12 @@
 #include <vata/vata.hh>
 
 // Standard library headers
+#include <unordered_map>
 #include <vector>
 
 
 #include "explicit_tree_aut_core.hh"
+#include "explicit_tree_frozen.hh"
 
 using VATA::ExplicitTreeAutCore;
 
@@ -24,6 +26,11 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 	const ExplicitTreeAutCore&           rhs,
 	VATA::AutBase::ProductTranslMap*     pTranslMap)
 {
+	if (lhs.IsFrozen() && rhs.IsFrozen())
+	{
+		return ExplicitTreeAutCore::intersectionFrozen(lhs, rhs, pTranslMap);
+	}
+
 	VATA::AutBase::ProductTranslMap translMap;
 
 	if (nullptr == pTranslMap)
@@ -31,7 +38,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 		pTranslMap = &translMap;
 	}
 
-	ExplicitTreeAutCore res(lhs.cache_);
+	ExplicitTreeAutCore res(lhs.cache_, lhs.alphabet_);
 
 	std::vector<const VATA::AutBase::ProductTranslMap::value_type*> stack;
 
@@ -51,6 +58,12 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 
 	auto transitions = res.transitions_;
 
+	// products of pairs of tuples, every pair is translated only once
+	std::unordered_map<std::pair<const StateTuple*, const StateTuple*>, TuplePtr,
+		boost::hash<std::pair<const StateTuple*, const StateTuple*>>> tupleMap;
+
+	StateTuple children;
+
 	while (!stack.empty())
 	{
 		auto p = stack.back();
@@ -101,7 +114,17 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 				{
 					assert(leftTuplePtr->size() == rightTuplePtr->size());
 
-					ExplicitTreeAutCore::StateTuple children;
+					auto itTuple = tupleMap.insert(std::make_pair(
+						std::make_pair(leftTuplePtr.get(), rightTuplePtr.get()),
+						TuplePtr(nullptr))).first;
+
+					if (nullptr != itTuple->second)
+					{	// the product of the tuples has already been computed
+						tuplePtrSet->insert(itTuple->second);
+						continue;
+					}
+
+					children.clear();
 
 					for (size_t i = 0; i < leftTuplePtr->size(); ++i)
 					{
@@ -121,9 +144,159 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Intersection(
 					}
 
 //					res.AddTransition(children, leftSymbolStateTupleSetPtr.first, p->second);
-					tuplePtrSet->insert(res.tupleLookup(children));
+					itTuple->second = res.tupleLookup(children);
+					tuplePtrSet->insert(itTuple->second);
+				}
+			}
+		}
+	}
+
+	return res;
+}
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::intersectionFrozen(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	VATA::AutBase::ProductTranslMap*     pTranslMap)
+{
+	using IndexType = FrozenTransitions::IndexType;
+
+	assert(nullptr != lhs.frozen_);
+	assert(nullptr != rhs.frozen_);
+
+	const FrozenTransitions& lhsTrans = *lhs.frozen_;
+	const FrozenTransitions& rhsTrans = *rhs.frozen_;
+
+	VATA::AutBase::ProductTranslMap translMap;
+
+	if (nullptr == pTranslMap)
+	{
+		pTranslMap = &translMap;
+	}
+
+	ExplicitTreeAutCore res(lhs.cache_, lhs.alphabet_);
+
+	std::vector<const VATA::AutBase::ProductTranslMap::value_type*> stack;
+
+	for (const StateType& s : lhs.finalStates_)
+	{
+		for (const StateType& t : rhs.finalStates_)
+		{
+			auto u = pTranslMap->insert(
+				std::make_pair(std::make_pair(s, t), pTranslMap->size())
+			).first;
+
+			res.SetStateFinal(u->second);
+
+			stack.push_back(&*u);
+		}
+	}
+
+	auto transitions = res.transitions_;
+
+	// products of pairs of tuple IDs, every pair is translated only once
+	std::unordered_map<uint64_t, TuplePtr> tupleMap;
+
+	StateTuple children;
+
+	while (!stack.empty())
+	{
+		auto p = stack.back();
+
+		stack.pop_back();
+
+		IndexType lhsParent = lhsTrans.FindParent(p->first.first);
+		if (FrozenTransitions::NotFound == lhsParent)
+		{
+			continue;
+		}
+
+		IndexType rhsParent = rhsTrans.FindParent(p->first.second);
+		if (FrozenTransitions::NotFound == rhsParent)
+		{
+			continue;
+		}
+
+		ExplicitTreeAutCore::TransitionClusterPtr cluster(nullptr);
+
+		// symbols of both parents are sorted, so we can merge them
+		IndexType i = lhsTrans.SymbolBegin(lhsParent);
+		IndexType j = rhsTrans.SymbolBegin(rhsParent);
+		const IndexType iEnd = lhsTrans.SymbolEnd(lhsParent);
+		const IndexType jEnd = rhsTrans.SymbolEnd(rhsParent);
+
+		while ((i < iEnd) && (j < jEnd))
+		{
+			const SymbolType& symbol = lhsTrans.GetSymbol(i);
+
+			if (symbol < rhsTrans.GetSymbol(j))
+			{
+				++i;
+				continue;
+			}
+
+			if (rhsTrans.GetSymbol(j) < symbol)
+			{
+				++j;
+				continue;
+			}
+
+			if (!cluster)
+			{
+				cluster = transitions->uniqueCluster(p->second);
+			}
+
+			auto tuplePtrSet = cluster->uniqueTuplePtrSet(symbol);
+
+			for (IndexType k = lhsTrans.TupleBegin(i); k < lhsTrans.TupleEnd(i); ++k)
+			{
+				const FrozenTransitions::TupleIdType lhsTuple = lhsTrans.GetTupleId(k);
+				const StateType* lhsStates = lhsTrans.TupleData(lhsTuple);
+
+				for (IndexType m = rhsTrans.TupleBegin(j); m < rhsTrans.TupleEnd(j); ++m)
+				{
+					const FrozenTransitions::TupleIdType rhsTuple = rhsTrans.GetTupleId(m);
+					const StateType* rhsStates = rhsTrans.TupleData(rhsTuple);
+
+					assert(lhsTrans.TupleSize(lhsTuple) == rhsTrans.TupleSize(rhsTuple));
+
+					auto itTuple = tupleMap.insert(std::make_pair(
+						(static_cast<uint64_t>(lhsTuple) << 32) | rhsTuple,
+						TuplePtr(nullptr))).first;
+
+					if (nullptr != itTuple->second)
+					{	// the product of the tuples has already been computed
+						tuplePtrSet->insert(itTuple->second);
+						continue;
+					}
+
+					children.clear();
+
+					for (size_t n = 0; n < lhsTrans.TupleSize(lhsTuple); ++n)
+					{
+						auto u = pTranslMap->insert(
+							std::make_pair(
+								std::make_pair(lhsStates[n], rhsStates[n]),
+								pTranslMap->size()
+							)
+						);
+
+						if (u.second)
+						{
+							stack.push_back(&*u.first);
+						}
+
+						children.push_back(u.first->second);
+					}
+
+					itTuple->second = res.tupleLookup(children);
+					tuplePtrSet->insert(itTuple->second);
 				}
 			}
+
+			++i;
+			++j;
 		}
 	}
 
@@ -0,0 +1,324 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of IsIntersectionEmpty() on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <unordered_map>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+#include "explicit_tree_bu_index.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+namespace
+{
+	using StateType        = ExplicitTreeAutCore::StateType;
+	using SymbolType       = ExplicitTreeAutCore::SymbolType;
+	using StateTuple       = ExplicitTreeAutCore::StateTuple;
+
+	using BottomUpIndex    = VATA::ExplicitTreeAutCoreUtil::BottomUpIndex;
+
+	/**
+	 * @brief  Iterates over all combinations of elements of several lists
+	 *
+	 * The @p func functor is called with the vector of indices into the lists.
+	 * It returns @p true to stop the enumeration.
+	 *
+	 * @returns  @p true in case the enumeration was stopped by @p func
+	 */
+	template <
+		class List,
+		class Func>
+	bool forAllCombinations(
+		const std::vector<List>&         lists,
+		Func                             func)
+	{
+		for (const List& list : lists)
+		{
+			if (list.empty())
+			{
+				return false;
+			}
+		}
+
+		std::vector<size_t> indices(lists.size(), 0);
+
+		while (true)
+		{
+			if (func(indices))
+			{
+				return true;
+			}
+
+			size_t i = 0;
+			while ((i < indices.size()) && (++indices[i] == lists[i].size()))
+			{
+				indices[i] = 0;
+				++i;
+			}
+
+			if (i == indices.size())
+			{
+				return false;
+			}
+		}
+	}
+}
+
+
+bool ExplicitTreeAutCore::IsIntersectionEmpty(
+	const std::vector<const ExplicitTreeAutCore*>&   auts,
+	ExplicitTreeAutCore*                             pWitness)
+{
+	struct ProductInfo
+	{
+		StateTuple states;
+		SymbolType symbol;
+		StateTuple children;
+
+		ProductInfo(
+			const StateTuple&      states,
+			const SymbolType&      symbol,
+			const StateTuple&      children) :
+			states(states),
+			symbol(symbol),
+			children(children)
+		{ }
+	};
+
+	assert(!auts.empty());
+
+	const size_t autCnt = auts.size();
+
+	for (const ExplicitTreeAutCore* aut : auts)
+	{
+		assert(nullptr != aut);
+
+		if (aut->finalStates_.empty())
+		{
+			return true;
+		}
+	}
+
+	std::vector<const BottomUpIndex*> indices;
+	indices.reserve(autCnt);
+	for (const ExplicitTreeAutCore* aut : auts)
+	{
+		indices.push_back(&aut->GetBottomUpIndex());
+	}
+
+	// the product states that are known to accept some tree, together with
+	// the transition by which they were reached
+	std::unordered_map<StateTuple, StateType, boost::hash<StateTuple>> productMap;
+	std::vector<ProductInfo> products;
+	std::vector<StateType> newProducts;
+
+	// adds a product state, returns true in case it is accepting
+	auto addProduct = [&](
+		const StateTuple&      states,
+		const SymbolType&      symbol,
+		const StateTuple&      children) -> bool
+	{
+		if (!productMap.insert(std::make_pair(states, products.size())).second)
+		{
+			return false;
+		}
+
+		newProducts.push_back(products.size());
+		products.push_back(ProductInfo(states, symbol, children));
+
+		for (size_t j = 0; j < autCnt; ++j)
+		{
+			if (!auts[j]->IsStateFinal(states[j]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	bool found = false;
+	StateTuple states(autCnt);
+	StateTuple children;
+
+	// nullary transitions
+	for (auto& symbolStatesPair : indices[0]->GetLeaves())
+	{
+		std::vector<std::vector<StateType>> lists(1, symbolStatesPair.second);
+
+		for (size_t j = 1; j < autCnt; ++j)
+		{
+			auto it = indices[j]->GetLeaves().find(symbolStatesPair.first);
+			if (indices[j]->GetLeaves().end() == it)
+			{
+				lists.clear();
+				break;
+			}
+
+			lists.push_back(it->second);
+		}
+
+		if (lists.empty())
+		{
+			continue;
+		}
+
+		found = forAllCombinations(lists, [&](const std::vector<size_t>& indexes)
+			{
+				for (size_t j = 0; j < autCnt; ++j)
+				{
+					states[j] = lists[j][indexes[j]];
+				}
+
+				return addProduct(states, symbolStatesPair.first, StateTuple());
+			});
+
+		if (found)
+		{
+			break;
+		}
+	}
+
+	// saturation: a product of transitions is fired once all its children are
+	// known to accept some tree
+	while (!found && !newProducts.empty())
+	{
+		const StateType product = newProducts.back();
+		newProducts.pop_back();
+
+		// copy, the vector of products may be reallocated
+		const StateTuple productStates = products[product].states;
+
+		for (const BottomUpIndex::Occurrence& occ :
+			indices[0]->GetOccurrences(productStates[0]))
+		{
+			const BottomUpIndex::Transition& first = indices[0]->GetTransition(occ.first);
+			const size_t pos = occ.second;
+
+			// transitions of other automata over the same symbol with the other
+			// component of the product at the same position
+			std::vector<std::vector<size_t>> lists(1, std::vector<size_t>(1, occ.first));
+			for (size_t j = 1; j < autCnt; ++j)
+			{
+				lists.push_back(std::vector<size_t>());
+				for (const BottomUpIndex::Occurrence& otherOcc :
+					indices[j]->GetOccurrences(productStates[j]))
+				{
+					if ((otherOcc.second == pos) &&
+						(indices[j]->GetTransition(otherOcc.first).symbol == first.symbol))
+					{
+						lists.back().push_back(otherOcc.first);
+					}
+				}
+
+				if (lists.back().empty())
+				{
+					break;
+				}
+			}
+
+			found = forAllCombinations(lists, [&](const std::vector<size_t>& indexes)
+				{
+					children.clear();
+
+					for (size_t i = 0; i < first.children->size(); ++i)
+					{
+						if (i == pos)
+						{
+							children.push_back(product);
+							continue;
+						}
+
+						for (size_t j = 0; j < autCnt; ++j)
+						{
+							states[j] = (*indices[j]->GetTransition(lists[j][indexes[j]]).children)[i];
+						}
+
+						auto it = productMap.find(states);
+						if (productMap.end() == it)
+						{
+							return false;
+						}
+
+						children.push_back(it->second);
+					}
+
+					for (size_t j = 0; j < autCnt; ++j)
+					{
+						states[j] = indices[j]->GetTransition(lists[j][indexes[j]]).parent;
+					}
+
+					return addProduct(states, first.symbol, children);
+				});
+
+			if (found)
+			{
+				break;
+			}
+		}
+	}
+
+	if (!found)
+	{
+		return true;
+	}
+
+	if (nullptr != pWitness)
+	{	// build the automaton accepting the witness tree; the last product
+		// state is the accepting one
+		ExplicitTreeAutCore witness(auts[0]->cache_, auts[0]->alphabet_);
+
+		const StateType root = products.size() - 1;
+		witness.SetStateFinal(root);
+
+		std::vector<bool> processed(products.size(), false);
+		std::vector<StateType> stack(1, root);
+		processed[root] = true;
+
+		while (!stack.empty())
+		{
+			const StateType product = stack.back();
+			stack.pop_back();
+
+			const ProductInfo& info = products[product];
+			witness.AddTransition(info.children, info.symbol, product);
+
+			for (const StateType& child : info.children)
+			{
+				if (!processed[child])
+				{
+					processed[child] = true;
+					stack.push_back(child);
+				}
+			}
+		}
+
+		*pWitness = witness;
+	}
+
+	return false;
+}
+
+
+bool ExplicitTreeAutCore::IsIntersectionEmpty(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	ExplicitTreeAutCore*                 pWitness)
+{
+	std::vector<const ExplicitTreeAutCore*> auts;
+	auts.push_back(&lhs);
+	auts.push_back(&rhs);
+
+	return ExplicitTreeAutCore::IsIntersectionEmpty(auts, pWitness);
+}
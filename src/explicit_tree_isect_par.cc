@@ -0,0 +1,517 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Implementation of parallel Intersection() on explicit tree automata.
+ *
+ *****************************************************************************/
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "explicit_tree_aut_core.hh"
+
+using VATA::ExplicitTreeAutCore;
+
+namespace
+{
+	using StateType        = ExplicitTreeAutCore::StateType;
+	using SymbolType       = ExplicitTreeAutCore::SymbolType;
+	using StateTuple       = ExplicitTreeAutCore::StateTuple;
+	using TuplePtr         = VATA::ExplicitTreeAutCoreUtil::TuplePtr;
+	using TuplePtrSet      = VATA::ExplicitTreeAutCoreUtil::TuplePtrSet;
+	using TuplePtrSetPtr   = VATA::ExplicitTreeAutCoreUtil::TuplePtrSetPtr;
+	using TransitionCluster    = VATA::ExplicitTreeAutCoreUtil::TransitionCluster;
+	using TransitionClusterPtr = VATA::ExplicitTreeAutCoreUtil::TransitionClusterPtr;
+	using StatePair        = VATA::AutBase::StatePair;
+	using ProductTranslMap = VATA::AutBase::ProductTranslMap;
+
+	/**
+	 * @brief  Map of pairs of states to product states shared by threads
+	 *
+	 * The map is split into shards, each of them guarded by its own mutex, so
+	 * that threads seldom wait for each other.
+	 */
+	class ConcurrentProductMap
+	{
+	private:  // data types
+
+		struct Shard
+		{
+			std::mutex mutex;
+			ProductTranslMap map;
+
+			Shard() :
+				mutex(),
+				map()
+			{ }
+		};
+
+	private:  // data members
+
+		std::vector<Shard> shards_;
+		std::atomic<StateType> nextState_;
+
+	private:  // methods
+
+		ConcurrentProductMap(const ConcurrentProductMap&);
+		ConcurrentProductMap& operator=(const ConcurrentProductMap&);
+
+	public:   // methods
+
+		explicit ConcurrentProductMap(size_t shardCnt) :
+			shards_(shardCnt),
+			nextState_(0)
+		{ }
+
+		/**
+		 * @brief  Translates a pair of states to a product state
+		 *
+		 * @param[in]  statePair  The pair of states
+		 *
+		 * @returns  The product state and @p true in case it has been created by
+		 *           this call
+		 */
+		std::pair<StateType, bool> Insert(const StatePair& statePair)
+		{
+			Shard& shard = shards_[boost::hash<StatePair>()(statePair) % shards_.size()];
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto it = shard.map.find(statePair);
+			if (shard.map.end() != it)
+			{
+				return std::make_pair(it->second, false);
+			}
+
+			StateType state = nextState_++;
+			shard.map.insert(std::make_pair(statePair, state));
+
+			return std::make_pair(state, true);
+		}
+
+		void Seed(const ProductTranslMap& translMap)
+		{
+			for (auto& pairStatePair : translMap)
+			{
+				Shard& shard = shards_[boost::hash<StatePair>()(pairStatePair.first) % shards_.size()];
+				shard.map.insert(pairStatePair);
+			}
+
+			nextState_ = translMap.size();
+		}
+
+		void CopyTo(ProductTranslMap& translMap) const
+		{
+			for (const Shard& shard : shards_)
+			{
+				translMap.insert(shard.map.begin(), shard.map.end());
+			}
+		}
+	};
+
+
+	struct ProductState
+	{
+		StatePair statePair;
+		StateType state;
+
+		ProductState() :
+			statePair(),
+			state()
+		{ }
+
+		ProductState(const StatePair& statePair, const StateType& state) :
+			statePair(statePair),
+			state(state)
+		{ }
+	};
+
+
+	/**
+	 * @brief  Double-ended queue of product states to be processed
+	 *
+	 * The owning thread works at the back of the queue, other threads steal from
+	 * the front, i.e., they take the oldest (and usually biggest) pieces of work.
+	 */
+	class WorkDeque
+	{
+	private:  // data members
+
+		std::mutex mutex_;
+		std::deque<ProductState> items_;
+
+	public:   // methods
+
+		WorkDeque() :
+			mutex_(),
+			items_()
+		{ }
+
+		void Push(const ProductState& item)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			items_.push_back(item);
+		}
+
+		bool Pop(ProductState& item)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (items_.empty())
+			{
+				return false;
+			}
+
+			item = items_.back();
+			items_.pop_back();
+			return true;
+		}
+
+		bool Steal(ProductState& item)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (items_.empty())
+			{
+				return false;
+			}
+
+			item = items_.front();
+			items_.pop_front();
+			return true;
+		}
+
+		bool Empty()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return items_.empty();
+		}
+	};
+
+
+	/**
+	 * @brief  Transitions of a single product state
+	 *
+	 * The tuples are indices into the product tuples of the thread that
+	 * processed the state.
+	 */
+	struct ProductCluster
+	{
+		using SymbolTuplesPair = std::pair<SymbolType, std::vector<size_t>>;
+
+		StateType parent;
+		std::vector<SymbolTuplesPair> symbolTuples;
+
+		explicit ProductCluster(const StateType& parent) :
+			parent(parent),
+			symbolTuples()
+		{ }
+	};
+
+
+	/**
+	 * @brief  The part of the product computed by a single thread
+	 */
+	struct WorkerOutput
+	{
+		std::vector<StateTuple> tuples;
+		std::vector<TuplePtr> tuplePtrs;
+		std::vector<ProductCluster> clusters;
+		std::vector<std::pair<StateType, TransitionClusterPtr>> builtClusters;
+
+		WorkerOutput() :
+			tuples(),
+			tuplePtrs(),
+			clusters(),
+			builtClusters()
+		{ }
+	};
+}
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::ParallelIntersection(
+	const ExplicitTreeAutCore&           lhs,
+	const ExplicitTreeAutCore&           rhs,
+	size_t                               threadCnt,
+	VATA::AutBase::ProductTranslMap*     pTranslMap)
+{
+	if (0 == threadCnt)
+	{
+		threadCnt = std::thread::hardware_concurrency();
+	}
+
+	if (threadCnt <= 1)
+	{
+		return ExplicitTreeAutCore::Intersection(lhs, rhs, pTranslMap);
+	}
+
+	ConcurrentProductMap productMap(16 * threadCnt);
+	if (nullptr != pTranslMap)
+	{
+		productMap.Seed(*pTranslMap);
+	}
+
+	std::vector<WorkDeque> deques(threadCnt);
+	std::vector<WorkerOutput> outputs(threadCnt);
+
+	// the number of product states that are queued or being processed
+	std::atomic<size_t> pending(0);
+
+	// idle threads sleep until new work appears or the product is complete
+	std::mutex idleMutex;
+	std::condition_variable idleCond;
+	std::atomic<size_t> sleeping(0);
+
+	ExplicitTreeAutCore res(lhs.cache_, lhs.alphabet_);
+
+	size_t initialDeque = 0;
+	for (const StateType& s : lhs.finalStates_)
+	{
+		for (const StateType& t : rhs.finalStates_)
+		{
+			auto u = productMap.Insert(std::make_pair(s, t));
+
+			res.SetStateFinal(u.first);
+
+			++pending;
+			deques[initialDeque].Push(ProductState(std::make_pair(s, t), u.first));
+			initialDeque = (initialDeque + 1) % threadCnt;
+		}
+	}
+
+	auto wakeIdle = [&]()
+	{
+		if (0 != sleeping)
+		{
+			std::lock_guard<std::mutex> lock(idleMutex);
+			idleCond.notify_all();
+		}
+	};
+
+	auto anyWork = [&]() -> bool
+	{
+		for (WorkDeque& deque : deques)
+		{
+			if (!deque.Empty())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	auto explore = [&](size_t id)
+	{
+		WorkDeque& own = deques[id];
+		WorkerOutput& output = outputs[id];
+
+		// products of pairs of tuples, every pair is translated only once
+		std::unordered_map<std::pair<const StateTuple*, const StateTuple*>, size_t,
+			boost::hash<std::pair<const StateTuple*, const StateTuple*>>> tupleMap;
+
+		ProductState item;
+
+		while (true)
+		{
+			bool found = own.Pop(item);
+			for (size_t i = 1; !found && (i < threadCnt); ++i)
+			{
+				found = deques[(id + i) % threadCnt].Steal(item);
+			}
+
+			if (!found)
+			{
+				std::unique_lock<std::mutex> lock(idleMutex);
+				if (0 == pending)
+				{
+					break;
+				}
+
+				// the checks are made while holding the lock, so a thread that
+				// publishes work (or completes the product) after them notices the
+				// sleeper and wakes it up
+				++sleeping;
+				if (!anyWork() && (0 != pending))
+				{
+					idleCond.wait(lock);
+				}
+				--sleeping;
+
+				continue;
+			}
+
+			auto leftCluster = ExplicitTreeAutCore::genericLookup(
+				*lhs.transitions_, item.statePair.first);
+
+			auto rightCluster = (nullptr == leftCluster)? nullptr :
+				ExplicitTreeAutCore::genericLookup(*rhs.transitions_, item.statePair.second);
+
+			if (nullptr != rightCluster)
+			{
+				ProductCluster cluster(item.state);
+				bool pushed = false;
+
+				for (auto& leftSymbolStateTupleSetPtr : *leftCluster)
+				{
+					auto rightTupleSet = ExplicitTreeAutCore::genericLookup(
+						*rightCluster, leftSymbolStateTupleSetPtr.first);
+
+					if (!rightTupleSet || rightTupleSet->empty())
+					{
+						continue;
+					}
+
+					cluster.symbolTuples.push_back(ProductCluster::SymbolTuplesPair(
+						leftSymbolStateTupleSetPtr.first, std::vector<size_t>()));
+					std::vector<size_t>& tuples = cluster.symbolTuples.back().second;
+
+					for (auto& leftTuplePtr : *leftSymbolStateTupleSetPtr.second)
+					{
+						for (auto& rightTuplePtr : *rightTupleSet)
+						{
+							assert(leftTuplePtr->size() == rightTuplePtr->size());
+
+							auto itTuple = tupleMap.insert(std::make_pair(
+								std::make_pair(leftTuplePtr.get(), rightTuplePtr.get()),
+								output.tuples.size()));
+
+							if (itTuple.second)
+							{
+								StateTuple children;
+								for (size_t i = 0; i < leftTuplePtr->size(); ++i)
+								{
+									StatePair statePair((*leftTuplePtr)[i], (*rightTuplePtr)[i]);
+
+									auto u = productMap.Insert(statePair);
+
+									if (u.second)
+									{
+										++pending;
+										own.Push(ProductState(statePair, u.first));
+										pushed = true;
+									}
+
+									children.push_back(u.first);
+								}
+
+								output.tuples.push_back(children);
+							}
+
+							tuples.push_back(itTuple.first->second);
+						}
+					}
+
+					if (tuples.empty())
+					{
+						cluster.symbolTuples.pop_back();
+					}
+				}
+
+				if (!cluster.symbolTuples.empty())
+				{
+					output.clusters.push_back(std::move(cluster));
+				}
+
+				if (pushed)
+				{
+					wakeIdle();
+				}
+			}
+
+			if (0 == --pending)
+			{
+				std::lock_guard<std::mutex> lock(idleMutex);
+				idleCond.notify_all();
+			}
+		}
+	};
+
+	// builds the transition clusters of the product states processed by
+	// a thread from its interned tuples
+	auto buildClusters = [](WorkerOutput& output)
+	{
+		output.builtClusters.reserve(output.clusters.size());
+
+		for (const ProductCluster& cluster : output.clusters)
+		{
+			TransitionClusterPtr transCluster(new TransitionCluster());
+
+			for (const ProductCluster::SymbolTuplesPair& symbolTuples : cluster.symbolTuples)
+			{
+				TuplePtrSetPtr tupleSet(new TuplePtrSet());
+
+				for (size_t tuple : symbolTuples.second)
+				{
+					tupleSet->insert(output.tuplePtrs[tuple]);
+				}
+
+				transCluster->insert(std::make_pair(symbolTuples.first, tupleSet));
+			}
+
+			output.builtClusters.push_back(std::make_pair(cluster.parent, transCluster));
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCnt; ++i)
+	{
+		threads.push_back(std::thread(explore, i));
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// the tuple cache is not shared by the threads, so the tuples are interned
+	// here; every thread's tuples are distinct, so this is done once per tuple
+	for (WorkerOutput& output : outputs)
+	{
+		output.tuplePtrs.reserve(output.tuples.size());
+		for (const StateTuple& tuple : output.tuples)
+		{
+			output.tuplePtrs.push_back(res.tupleLookup(tuple));
+		}
+	}
+
+	threads.clear();
+	for (size_t i = 0; i < threadCnt; ++i)
+	{
+		threads.push_back(std::thread(buildClusters, std::ref(outputs[i])));
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// every product state is processed by exactly one thread, so the clusters
+	// are disjoint and are merged by moving them into the result
+	auto clusterMap = res.uniqueClusterMap();
+	for (WorkerOutput& output : outputs)
+	{
+		for (auto& stateClusterPair : output.builtClusters)
+		{
+			clusterMap->insert(std::move(stateClusterPair));
+		}
+	}
+
+	if (nullptr != pTranslMap)
+	{
+		productMap.CopyTo(*pTranslMap);
+	}
+
+	return res;
+}
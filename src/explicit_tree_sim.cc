@@ -26,7 +26,8 @@ StateBinaryRelation ExplicitTreeAutCore::ComputeUpwardSimulation(
 {
 	if (params.GetNumStates() != static_cast<size_t>(-1))
 	{
-		return this->ComputeUpwardSimulation(params.GetNumStates());
+		return this->ComputeUpwardSimulation(
+			params.GetNumStates(), params.GetThreadCount());
 	}
 	else
 	{
@@ -40,7 +41,8 @@ StateBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
 {
 	if (params.GetNumStates() != static_cast<size_t>(-1))
 	{
-		return this->ComputeDownwardSimulation(params.GetNumStates());
+		return this->ComputeDownwardSimulation(
+			params.GetNumStates(), params.GetThreadCount());
 	}
 	else
 	{
@@ -70,8 +72,9 @@ StateBinaryRelation ExplicitTreeAutCore::ComputeSimulation(
 }
 
 StateBinaryRelation ExplicitTreeAutCore::ComputeDownwardSimulation(
-	size_t            size) const
+	size_t            size,
+	size_t            threadCnt) const
 {
-	return this->TranslateDownward().computeSimulation(size);
+	return this->TranslateDownward().computeSimulation(size, threadCnt);
 }
 
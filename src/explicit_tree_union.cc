@@ -37,7 +37,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::Union(
 	StateToStateTranslWeak stateTransLhs(*pTranslMapLhs, translFunc);
 	StateToStateTranslWeak stateTransRhs(*pTranslMapRhs, translFunc);
 
-	ExplicitTreeAutCore res(lhs.cache_);
+	ExplicitTreeAutCore res(lhs.cache_, lhs.alphabet_);
 
 	lhs.ReindexStates(res, stateTransLhs);
 	rhs.ReindexStates(res, stateTransRhs);
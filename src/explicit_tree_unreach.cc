@@ -72,7 +72,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUnreachableStates(
 		return *this;
 	}
 
-	ExplicitTreeAutCore result(cache_);
+	ExplicitTreeAutCore result(cache_, alphabet_);
 
 	result.finalStates_ = finalStates_;
 	result.transitions_ = StateToTransitionClusterMapPtr(
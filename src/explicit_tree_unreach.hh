@@ -176,7 +176,7 @@ VATA::ExplicitTreeAutCore VATA::ExplicitTreeAutCore::RemoveUnreachableStates(
 		return *this;
 	}
 
-	ExplicitTreeAutCore result(cache_);
+	ExplicitTreeAutCore result(cache_, alphabet_);
 
 	result.finalStates_.insert(finalStates.data().begin(), finalStates.data().end());
 
@@ -12,128 +12,162 @@
 #include <vata/vata.hh>
 
 // Standard library headers
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "explicit_tree_aut_core.hh"
+#include "explicit_tree_bu_index.hh"
+#include "explicit_tree_frozen.hh"
 
 
 using VATA::ExplicitTreeAutCore;
 
 using StateToStateMap    = VATA::AutBase::StateToStateMap;
+using StateType          = VATA::AutBase::StateType;
 
-ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
-	StateToStateMap*            pTranslMap) const
+namespace
 {
-	struct TransitionInfo
+	/**
+	 * @brief  Bottom-up saturation of useful states
+	 *
+	 * The saturation is shared by both layouts of the transitions. An item (a
+	 * transition, or a tuple of the frozen layout) is reached once all of its
+	 * children are useful, which makes the parents of the item useful.
+	 */
+	class UsefulStateSaturation
 	{
-		TuplePtr children_;
-		SymbolType symbol_;
-		StateType state_;
-
-		std::set<StateType> childrenSet_;
-
-		TransitionInfo(
-			const TuplePtr&      children,
-			const SymbolType&    symbol,
-			const StateType&     state) :
-			children_(children),
-			symbol_(symbol),
-			state_(state),
-			childrenSet_(children->begin(), children->end())
-		{ }
-
-		bool reachedBy(const StateType& state)
-		{
-			assert(childrenSet_.count(state));
-
-			childrenSet_.erase(state);
-
-			return childrenSet_.empty();
-		}
-	};
-
-	typedef std::shared_ptr<TransitionInfo> TransitionInfoPtr;
-
-	std::unordered_map<StateType, std::vector<TransitionInfoPtr>> stateMap;
-	std::unordered_set<StateType> reachableStates;
-	std::vector<TransitionInfoPtr> reachableTransitions;
-	std::vector<StateType> newStates;
-
-	assert(nullptr != transitions_);
-
-	size_t remaining = 0;
+	private:  // data members
 
-	for (auto& stateClusterPair : *transitions_) {
+		/// the number of children of every item not yet known to be useful
+		std::vector<size_t>& pending_;
 
-		assert(stateClusterPair.second);
+		std::vector<size_t> reachedItems_;
+		std::vector<StateType> newStates_;
+		std::unordered_set<StateType> usefulStates_;
 
-		for (auto& symbolTupleSetPair : *stateClusterPair.second) {
+	private:  // methods
 
-			assert(symbolTupleSetPair.second);
+		UsefulStateSaturation(const UsefulStateSaturation&);
+		UsefulStateSaturation& operator=(const UsefulStateSaturation&);
 
-			for (auto& tuple : *symbolTupleSetPair.second) {
+	public:   // methods
 
-				assert(tuple);
+		explicit UsefulStateSaturation(std::vector<size_t>& pending) :
+			pending_(pending),
+			reachedItems_(),
+			newStates_(),
+			usefulStates_()
+		{ }
 
-				auto transitionInfoPtr = TransitionInfoPtr(
-					new TransitionInfo(tuple, symbolTupleSetPair.first, stateClusterPair.first)
-				);
+		void AddUsefulState(const StateType& state)
+		{
+			if (usefulStates_.insert(state).second)
+			{
+				newStates_.push_back(state);
+			}
+		}
 
-				if (tuple->empty()) {
+		void AddReachedItem(size_t item)
+		{
+			reachedItems_.push_back(item);
+		}
 
-					reachableTransitions.push_back(transitionInfoPtr);
+		/**
+		 * @brief  Notes that one more child of an item is useful
+		 */
+		void DecrementItem(size_t item)
+		{
+			assert(0 < pending_[item]);
 
-					if (reachableStates.insert(stateClusterPair.first).second)
-						newStates.push_back(stateClusterPair.first);
+			if (0 == --pending_[item])
+			{
+				reachedItems_.push_back(item);
+			}
+		}
 
+		/**
+		 * @brief  Runs the saturation
+		 *
+		 * @param[in]  parentFunc  Called as @p parentFunc(item, *this), adds the
+		 *                         parents of a reached item using AddUsefulState()
+		 * @param[in]  occurFunc   Called as @p occurFunc(state, *this), calls
+		 *                         DecrementItem() for every occurrence of a new
+		 *                         useful state in an item
+		 */
+		template <class ParentFunc, class OccurFunc>
+		void Run(ParentFunc parentFunc, OccurFunc occurFunc)
+		{
+			while (!reachedItems_.empty() || !newStates_.empty())
+			{
+				if (!reachedItems_.empty())
+				{
+					size_t item = reachedItems_.back();
+					reachedItems_.pop_back();
+
+					parentFunc(item, *this);
 					continue;
-
 				}
 
-				for (auto& s : transitionInfoPtr->childrenSet_) {
-
-					stateMap.insert(
-						std::make_pair(s, std::vector<TransitionInfoPtr>())
-					).first->second.push_back(transitionInfoPtr);
-
-					++remaining;
-
-				}
+				StateType state = newStates_.back();
+				newStates_.pop_back();
 
+				occurFunc(state, *this);
 			}
+		}
 
+		const std::unordered_set<StateType>& GetUsefulStates() const
+		{
+			return usefulStates_;
 		}
+	};
+}
 
+ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
+	StateToStateMap*            pTranslMap) const
+{
+	if (nullptr != frozen_)
+	{
+		return this->removeUselessStatesFrozen(pTranslMap);
 	}
 
-	while (!newStates.empty()) {
+	const BottomUpIndex& index = this->GetBottomUpIndex();
 
-		auto i = stateMap.find(newStates.back());
+	// the number of children of every transition not yet known to be useful
+	std::vector<size_t> pending(index.TransitionCount());
+	for (size_t i = 0; i < pending.size(); ++i)
+		pending[i] = index.GetTransition(i).children->size();
 
-		newStates.pop_back();
+	UsefulStateSaturation saturation(pending);
 
-		if (i == stateMap.end())
-			continue;
+	for (auto& trans : index.GetLeafTransitions())
+		saturation.AddUsefulState(trans.parent);
 
-		for (auto& info : i->second) {
+	saturation.Run(
+		[&index](size_t i, UsefulStateSaturation& sat)
+		{
+			sat.AddUsefulState(index.GetTransition(i).parent);
+		},
+		[&index](const StateType& state, UsefulStateSaturation& sat)
+		{
+			for (auto& occ : index.GetOccurrences(state))
+				sat.DecrementItem(occ.first);
+		});
 
-			assert(info);
+	const std::unordered_set<StateType>& reachableStates =
+		saturation.GetUsefulStates();
 
-			if (!info->reachedBy(i->first))
-				continue;
+	std::vector<size_t> reachableTransitions;
+	for (size_t i = 0; i < pending.size(); ++i) {
 
-			reachableTransitions.push_back(info);
+		if (!pending[i])
+			reachableTransitions.push_back(i);
 
-			--remaining;
-
-			if (reachableStates.insert(info->state_).second)
-				newStates.push_back(info->state_);
+	}
 
-		}
+	size_t remaining = pending.size() - reachableTransitions.size();
 
-	}
 /*
 	if (pTranslMap) {
 
@@ -142,7 +176,7 @@ ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
 
 	}
 */
-	ExplicitTreeAutCore result(cache_);
+	ExplicitTreeAutCore result(cache_, alphabet_);
 
 	for (auto& state : finalStates_) {
 
@@ -154,19 +188,138 @@ ExplicitTreeAutCore ExplicitTreeAutCore::RemoveUselessStates(
 	if (!remaining) {
 
 		result.transitions_ = transitions_;
+		result.bottomUpIndex_ = bottomUpIndex_;
 
 		return result.RemoveUnreachableStates(pTranslMap);
 
 	}
 
-	for (auto& info : reachableTransitions) {
+	for (auto& trans : index.GetLeafTransitions())
+		result.internalAddTransition(trans.children, trans.symbol, trans.parent);
+
+	for (auto& i : reachableTransitions) {
 
-		assert(info);
+		auto& trans = index.GetTransition(i);
 
-		result.internalAddTransition(info->children_, info->symbol_, info->state_);
+		result.internalAddTransition(trans.children, trans.symbol, trans.parent);
 
 	}
 
 	return result.RemoveUnreachableStates(pTranslMap);
 
 }
+
+
+ExplicitTreeAutCore ExplicitTreeAutCore::removeUselessStatesFrozen(
+	StateToStateMap*            pTranslMap) const
+{
+	using IndexType   = FrozenTransitions::IndexType;
+	using TupleIdType = FrozenTransitions::TupleIdType;
+
+	assert(nullptr != frozen_);
+
+	const FrozenTransitions& frozen = *frozen_;
+
+	// the number of distinct children of every tuple that are not yet known to
+	// be useful, and the tuples in which a state occurs
+	std::vector<size_t> pending(frozen.TupleCount(), 0);
+	std::unordered_map<StateType, std::vector<TupleIdType>> stateMap;
+
+	// the parents of the transitions over every tuple
+	std::vector<std::vector<StateType>> tupleParents(frozen.TupleCount());
+
+	UsefulStateSaturation saturation(pending);
+
+	for (TupleIdType tupleId = 0; tupleId < frozen.TupleCount(); ++tupleId)
+	{
+		const StateType* data = frozen.TupleData(tupleId);
+		const size_t size = frozen.TupleSize(tupleId);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (std::find(data, data + i, data[i]) != data + i)
+			{	// skip duplicate children
+				continue;
+			}
+
+			stateMap[data[i]].push_back(tupleId);
+			++pending[tupleId];
+		}
+
+		if (0 == pending[tupleId])
+		{
+			saturation.AddReachedItem(tupleId);
+		}
+	}
+
+	for (IndexType parent = 0; parent < frozen.ParentCount(); ++parent)
+	{
+		for (IndexType sym = frozen.SymbolBegin(parent); sym < frozen.SymbolEnd(parent); ++sym)
+		{
+			for (IndexType k = frozen.TupleBegin(sym); k < frozen.TupleEnd(sym); ++k)
+			{
+				tupleParents[frozen.GetTupleId(k)].push_back(frozen.GetParent(parent));
+			}
+		}
+	}
+
+	saturation.Run(
+		[&tupleParents](size_t tupleId, UsefulStateSaturation& sat)
+		{
+			for (const StateType& parent : tupleParents[tupleId])
+			{
+				sat.AddUsefulState(parent);
+			}
+		},
+		[&stateMap](const StateType& state, UsefulStateSaturation& sat)
+		{
+			auto i = stateMap.find(state);
+			if (stateMap.end() == i)
+			{
+				return;
+			}
+
+			for (const TupleIdType& tupleId : i->second)
+			{
+				sat.DecrementItem(tupleId);
+			}
+		});
+
+	const std::unordered_set<StateType>& reachableStates =
+		saturation.GetUsefulStates();
+
+	ExplicitTreeAutCore result(cache_, alphabet_);
+
+	for (auto& state : finalStates_)
+	{
+		if (reachableStates.count(state))
+		{
+			result.SetStateFinal(state);
+		}
+	}
+
+	StateTuple children;
+	for (IndexType parent = 0; parent < frozen.ParentCount(); ++parent)
+	{
+		for (IndexType sym = frozen.SymbolBegin(parent); sym < frozen.SymbolEnd(parent); ++sym)
+		{
+			for (IndexType k = frozen.TupleBegin(sym); k < frozen.TupleEnd(sym); ++k)
+			{
+				const TupleIdType tupleId = frozen.GetTupleId(k);
+
+				if (0 != pending[tupleId])
+				{
+					continue;
+				}
+
+				const StateType* data = frozen.TupleData(tupleId);
+				children.assign(data, data + frozen.TupleSize(tupleId));
+
+				result.internalAddTransition(
+					result.tupleLookup(children), frozen.GetSymbol(sym), frozen.GetParent(parent));
+			}
+		}
+	}
+
+	return result.RemoveUnreachableStates(pTranslMap);
+}
@@ -46,5 +46,8 @@ std::string VATA::InclParam::toString() const
 	result += "Use simulation: ";
 	result += Convert::ToString(this->GetUseSimulation()) + "\n";
 
+	result += "Threads: ";
+	result += Convert::ToString(this->GetThreadCount()) + "\n";
+
 	return result;
 }
@@ -21,6 +21,7 @@
 #include <boost/functional/hash.hpp>
 
 #include	"ondriks_mtbdd.hh"
+#include "computed_table.hh"
 
 namespace VATA
 {
@@ -58,6 +59,15 @@ public:   // Public data types
 
 	typedef typename MTBDDOutType::VarType VarType;
 
+	/**
+	 * @brief  Whether results are shared among calls
+	 *
+	 * A derived class whose ApplyOperation() depends on its argument only may
+	 * redefine this constant as @p true; results of the operation are then
+	 * also kept in the ComputedTable and reused by subsequent calls.
+	 */
+	static const bool SHARED_CACHE = false;
+
 private:  // Private data types
 
 	typedef Node1PtrType CacheAddressType;
@@ -91,6 +101,14 @@ private:  // Private methods
 		// Assertions
 		assert(!IsNull(node1));
 
+		NodeOutPtrType cached = 0;
+		if (BaseClass::SHARED_CACHE &&
+			ComputedTable::Lookup(operationId(), cached, node1))
+		{	// if the result is known from a previous call
+			assert(!IsNull(cached));
+			return cached;
+		}
+
 		// TODO: optimize
 		if (IsLeaf(node1))
 		{	// for the terminal case
@@ -108,6 +126,7 @@ private:  // Private methods
 
 				// cache
 				ht.insert(std::make_pair(cacheAddress, result));
+				store(node1, result);
 				return result;
 			}
 		}
@@ -131,15 +150,34 @@ private:  // Private methods
 
 			if (lowOutTree == highOutTree)
 			{	// in case both trees are isomorphic (when caching is enabled)
+				store(node1, lowOutTree);
 				return lowOutTree;
 			}
 			else
 			{	// in case both trees are distinct
-				return MTBDDOutType::spawnInternal(lowOutTree, highOutTree, var);
+				NodeOutPtrType result =
+					MTBDDOutType::spawnInternal(lowOutTree, highOutTree, var);
+
+				store(node1, result);
+				return result;
 			}
 		}
 	}
 
+	static ComputedTable::OperationType operationId()
+	{
+		static const ComputedTable::OperationType op = ComputedTable::NewOperation();
+		return op;
+	}
+
+	void store(const Node1PtrType& node1, const NodeOutPtrType& result)
+	{
+		if (BaseClass::SHARED_CACHE)
+		{	// internal nodes are worth caching across calls
+			ComputedTable::Insert(operationId(), result, node1);
+		}
+	}
+
 	inline BaseClass& makeBase()
 	{
 		return static_cast<BaseClass&>(*this);
@@ -162,6 +200,8 @@ public:   // Public methods
 		// clear the cache
 		ht.clear();
 
+		GarbageCollectionLock lock;
+
 		// recursively descend the nodes and generate a new one
 		return recDescend(node1);
 	}
@@ -174,6 +214,8 @@ public:   // Public methods
 		// clear the cache
 		ht.clear();
 
+		GarbageCollectionLock lock;
+
 		// recursively descend the MTBDD and generate a new one
 		NodeOutPtrType root = recDescend(mtbdd1_->getRoot());
 		IncrementRefCnt(root);
@@ -22,6 +22,7 @@
 #include <boost/functional/hash.hpp>
 
 #include "ondriks_mtbdd.hh"
+#include "computed_table.hh"
 
 namespace VATA
 {
@@ -69,6 +70,15 @@ public:   // Public data types
 
 	typedef typename MTBDDOutType::VarType VarType;
 
+	/**
+	 * @brief  Whether results are shared among calls
+	 *
+	 * A derived class whose ApplyOperation() depends on its arguments only may
+	 * redefine this constant as @p true; results of the operation are then
+	 * also kept in the ComputedTable and reused by subsequent calls.
+	 */
+	static const bool SHARED_CACHE = false;
+
 private:  // Private data types
 
 
@@ -152,12 +162,11 @@ private:  // Private methods
 		assert(!IsNull(node2));
 		assert(!IsNull(node3));
 
-		CacheAddressType cacheAddress(node1, node2, node3);
-		typename CacheHashTable::iterator itHt;
-		if ((itHt = ht.find(cacheAddress)) != ht.end())
+		NodeOutPtrType cached = 0;
+		if (lookup(node1, node2, node3, cached))
 		{	// if the result is already known
-			assert(!IsNull(itHt->second));
-			return itHt->second;
+			assert(!IsNull(cached));
+			return cached;
 		}
 
 		char relation = classifyCase(node1, node2, node3);
@@ -168,7 +177,7 @@ private:  // Private methods
 			NodeOutPtrType result = MTBDDOutType::spawnLeaf(makeBase().ApplyOperation(
 				GetDataFromLeaf(node1), GetDataFromLeaf(node2), GetDataFromLeaf(node3)));
 
-			ht.insert(std::make_pair(cacheAddress, result));
+			store(node1, node2, node3, result);
 			return result;
 		}
 
@@ -227,7 +236,7 @@ private:  // Private methods
 
 		if (lowOutTree == highOutTree)
 		{	// in case both trees are isomorphic (when caching is enabled)
-			ht.insert(std::make_pair(cacheAddress, lowOutTree));
+			store(node1, node2, node3, lowOutTree);
 			return lowOutTree;
 		}
 		else
@@ -235,11 +244,53 @@ private:  // Private methods
 			NodeOutPtrType result =
 				MTBDDOutType::spawnInternal(lowOutTree, highOutTree, var);
 
-			ht.insert(std::make_pair(cacheAddress, result));
+			store(node1, node2, node3, result);
 			return result;
 		}
 	}
 
+	static ComputedTable::OperationType operationId()
+	{
+		static const ComputedTable::OperationType op = ComputedTable::NewOperation();
+		return op;
+	}
+
+	bool lookup(const Node1PtrType& node1,
+		const Node2PtrType& node2,
+		const Node3PtrType& node3,
+		NodeOutPtrType& result)
+	{
+		typename CacheHashTable::const_iterator itHt =
+			ht.find(CacheAddressType(node1, node2, node3));
+		if (itHt != ht.end())
+		{	// the result is known from this call
+			result = itHt->second;
+			return true;
+		}
+
+		if (BaseClass::SHARED_CACHE &&
+			ComputedTable::Lookup(operationId(), result, node1, node2, node3))
+		{	// the result is known from a previous call
+			ht.insert(std::make_pair(CacheAddressType(node1, node2, node3), result));
+			return true;
+		}
+
+		return false;
+	}
+
+	void store(const Node1PtrType& node1,
+		const Node2PtrType& node2,
+		const Node3PtrType& node3,
+		const NodeOutPtrType& result)
+	{
+		ht.insert(std::make_pair(CacheAddressType(node1, node2, node3), result));
+
+		if (BaseClass::SHARED_CACHE)
+		{
+			ComputedTable::Insert(operationId(), result, node1, node2, node3);
+		}
+	}
+
 	inline BaseClass& makeBase()
 	{
 		return static_cast<BaseClass&>(*this);
@@ -265,6 +316,8 @@ public:   // Public methods
 		// clear the cache
 		ht.clear();
 
+		GarbageCollectionLock lock;
+
 		// recursively descend the MTBDD and generate a new one
 		NodeOutPtrType root = recDescend(mtbdd1_->getRoot(), mtbdd2_->getRoot(),
 			mtbdd3_->getRoot());
@@ -21,6 +21,7 @@
 #include <boost/functional/hash.hpp>
 
 #include "ondriks_mtbdd.hh"
+#include "computed_table.hh"
 #include "apply1func.hh"
 #include "bool_classify_case.hh"
 
@@ -36,6 +37,9 @@ namespace VATA
     class AndApplyFunctor;
     class ImplicApplyFunctor;
     class EquivApplyFunctor;
+
+		template <class VarPredicate>
+		class AndExistsFunctor;
 	}
 }
 
@@ -51,6 +55,8 @@ GCC_DIAG_ON(effc++)
 
 public:
 
+	static const bool SHARED_CACHE = true;
+
 	bool ApplyOperation(const bool & val)
   {
     return !val;
@@ -74,6 +80,15 @@ public:   // Public data types
 
 	typedef typename MTBDDOutType::VarType VarType;
 
+	/**
+	 * @brief  Whether results are shared among calls
+	 *
+	 * A derived class whose ApplyOperation() depends on its arguments only may
+	 * redefine this constant as @p true; results of the operation are then
+	 * also kept in the ComputedTable and reused by subsequent calls.
+	 */
+	static const bool SHARED_CACHE = false;
+
 private:  // Private data types
 
 	typedef std::pair<Node1PtrType, Node2PtrType> CacheAddressType;
@@ -99,12 +114,11 @@ private:  // Private methods
 		assert(!IsNull(node1));
 		assert(!IsNull(node2));
 
-		CacheAddressType cacheAddress(node1, node2);
-		typename CacheHashTable::iterator itHt;
-		if ((itHt = ht.find(cacheAddress)) != ht.end())
+		NodeOutPtrType cached = 0;
+		if (lookup(node1, node2, cached))
 		{	// if the result is already known
-			assert(!IsNull(itHt->second));
-			return itHt->second;
+			assert(!IsNull(cached));
+			return cached;
 		}
 
 		char relation = BoolClassifyCase(node1, node2);
@@ -115,7 +129,7 @@ private:  // Private methods
       NodeOutPtrType result = makeBase().ApplyOperation(node1, node2);
       IncrementRefCnt(result); // not sure about placement of this
 
-			ht.insert(std::make_pair(cacheAddress, result));
+			store(node1, node2, result);
 			return result;
 		}
 
@@ -159,7 +173,7 @@ private:  // Private methods
 
 		if (lowOutTree == highOutTree)
 		{	// in case both trees are isomorphic (when caching is enabled)
-			ht.insert(std::make_pair(cacheAddress, lowOutTree));
+			store(node1, node2, lowOutTree);
 			return lowOutTree;
 		}
 		else
@@ -167,11 +181,51 @@ private:  // Private methods
 			NodeOutPtrType result =
 				MTBDDOutType::spawnInternal(lowOutTree, highOutTree, var);
 
-			ht.insert(std::make_pair(cacheAddress, result));
+			store(node1, node2, result);
 			return result;
 		}
 	}
 
+	static ComputedTable::OperationType operationId()
+	{
+		static const ComputedTable::OperationType op = ComputedTable::NewOperation();
+		return op;
+	}
+
+	bool lookup(const Node1PtrType& node1,
+		const Node2PtrType& node2,
+		NodeOutPtrType& result)
+	{
+		typename CacheHashTable::const_iterator itHt =
+			ht.find(CacheAddressType(node1, node2));
+		if (itHt != ht.end())
+		{	// the result is known from this call
+			result = itHt->second;
+			return true;
+		}
+
+		if (BaseClass::SHARED_CACHE &&
+			ComputedTable::Lookup(operationId(), result, node1, node2))
+		{	// the result is known from a previous call
+			ht.insert(std::make_pair(CacheAddressType(node1, node2), result));
+			return true;
+		}
+
+		return false;
+	}
+
+	void store(const Node1PtrType& node1,
+		const Node2PtrType& node2,
+		const NodeOutPtrType& result)
+	{
+		ht.insert(std::make_pair(CacheAddressType(node1, node2), result));
+
+		if (BaseClass::SHARED_CACHE)
+		{
+			ComputedTable::Insert(operationId(), result, node1, node2);
+		}
+	}
+
 	inline BaseClass& makeBase()
 	{
 		return static_cast<BaseClass&>(*this);
@@ -197,6 +251,8 @@ public:   // Public methods
 		// clear the cache
 		ht.clear();
 
+		GarbageCollectionLock lock;
+
 		// recursively descend the nodes and generate a new one
 		return recDescend(node1, node2);
 	}
@@ -210,6 +266,8 @@ public:   // Public methods
 		// clear the cache
 		ht.clear();
 
+		GarbageCollectionLock lock;
+
 		// recursively descend the MTBDD and generate a new one
 		NodeOutPtrType root = recDescend(mtbdd1_->getRoot(), mtbdd2_->getRoot());
 
@@ -242,6 +300,8 @@ GCC_DIAG_ON(effc++)
 
 public:
 
+	static const bool SHARED_CACHE = true;
+
 	NodeOutPtrType ApplyOperation(
     const Node1PtrType & node1,
     const Node2PtrType & node2
@@ -269,6 +329,8 @@ GCC_DIAG_ON(effc++)
 
 public:
 
+	static const bool SHARED_CACHE = true;
+
 	NodeOutPtrType ApplyOperation(
     const Node1PtrType & node1,
     const Node2PtrType & node2
@@ -296,6 +358,8 @@ GCC_DIAG_ON(effc++)
 
 public:
 
+	static const bool SHARED_CACHE = true;
+
 	NodeOutPtrType ApplyOperation(
     const Node1PtrType & node1,
     const Node2PtrType & node2
@@ -325,6 +389,8 @@ GCC_DIAG_ON(effc++)
 
 public:
 
+	static const bool SHARED_CACHE = true;
+
 	NodeOutPtrType ApplyOperation(
     const Node1PtrType & node1,
     const Node2PtrType & node2
@@ -346,4 +412,157 @@ public:
 	}
 };
 
+/**
+ * @brief  Relational product of Boolean MTBDDs
+ *
+ * Computes the conjunction of two Boolean MTBDDs and existentially quantifies
+ * the variables satisfying a predicate in a single recursive pass, so that
+ * the conjunction is never built as a whole. Quantified variables whose low
+ * branch already yields @p true need not descend into the high branch.
+ *
+ * @tparam  VarPredicate  Predicate denoting the variables to quantify out
+ */
+template <class VarPredicate>
+class VATA::MTBDDPkg::AndExistsFunctor
+{
+public:   // Public data types
+
+	typedef OndriksMTBDD<bool> MTBDDType;
+
+	typedef typename MTBDDType::NodePtrType NodePtrType;
+
+	typedef typename MTBDDType::VarType VarType;
+
+private:  // Private data types
+
+	typedef std::pair<NodePtrType, NodePtrType> CacheAddressType;
+
+	typedef std::unordered_map<CacheAddressType, NodePtrType,
+		boost::hash<CacheAddressType>> CacheHashTable;
+
+private:  // Private data members
+
+	VarPredicate pred_;
+
+	OrApplyFunctor orFunc_;
+
+	CacheHashTable ht;
+
+private:  // Private methods
+
+	AndExistsFunctor(const AndExistsFunctor&);
+	AndExistsFunctor& operator=(const AndExistsFunctor&);
+
+	static inline bool isFalse(const NodePtrType& node)
+	{
+		return IsLeaf(node) && !GetDataFromLeaf(node);
+	}
+
+	NodePtrType recDescend(const NodePtrType& node1, const NodePtrType& node2)
+	{
+		// Assertions
+		assert(!IsNull(node1));
+		assert(!IsNull(node2));
+
+		if (isFalse(node1))
+		{	// the conjunction is false
+			return node1;
+		}
+
+		if (isFalse(node2))
+		{
+			return node2;
+		}
+
+		if (IsLeaf(node1) && IsLeaf(node2))
+		{	// both are true
+			return node1;
+		}
+
+		typename CacheHashTable::const_iterator itHt =
+			ht.find(CacheAddressType(node1, node2));
+		if (itHt != ht.end())
+		{	// the result is already known
+			return itHt->second;
+		}
+
+		char relation = BoolClassifyCase(node1, node2);
+		if (IsLeaf(node1))
+		{	// the true leaf is neutral, descend in the other node only
+			relation = NODE2MASK;
+		}
+		else if (IsLeaf(node2))
+		{
+			relation = NODE1MASK;
+		}
+
+		VarType var = 0;
+		NodePtrType low1Tree = node1;
+		NodePtrType low2Tree = node2;
+		NodePtrType high1Tree = node1;
+		NodePtrType high2Tree = node2;
+
+		if (relation & NODE1MASK)
+		{	// if node1 is to be branched
+			var = GetVarFromInternal(node1);
+			low1Tree = GetLowFromInternal(node1);
+			high1Tree = GetHighFromInternal(node1);
+		}
+
+		if (relation & NODE2MASK)
+		{	// if node2 is to be branched
+			var = GetVarFromInternal(node2);
+			low2Tree = GetLowFromInternal(node2);
+			high2Tree = GetHighFromInternal(node2);
+		}
+
+		NodePtrType result = 0;
+		NodePtrType lowOutTree = recDescend(low1Tree, low2Tree);
+		if (pred_(var))
+		{	// the variable is quantified out
+			if (IsLeaf(lowOutTree) && GetDataFromLeaf(lowOutTree))
+			{	// the disjunction is already true
+				result = lowOutTree;
+			}
+			else
+			{
+				result = orFunc_(lowOutTree, recDescend(high1Tree, high2Tree));
+			}
+		}
+		else
+		{
+			NodePtrType highOutTree = recDescend(high1Tree, high2Tree);
+			result = (lowOutTree == highOutTree)? lowOutTree
+				: MTBDDType::spawnInternal(lowOutTree, highOutTree, var);
+		}
+
+		ht.insert(std::make_pair(CacheAddressType(node1, node2), result));
+		return result;
+	}
+
+public:   // Public methods
+
+	explicit AndExistsFunctor(VarPredicate pred) :
+		pred_(pred),
+		orFunc_(),
+		ht()
+	{ }
+
+	MTBDDType operator()(const MTBDDType& mtbdd1, const MTBDDType& mtbdd2)
+	{
+		// clear the cache
+		ht.clear();
+
+		GarbageCollectionLock lock;
+
+		NodePtrType root = recDescend(mtbdd1.getRoot(), mtbdd2.getRoot());
+		ht.clear();
+
+		IncrementRefCnt(root);
+
+		// wrap it all up
+		return MTBDDType(root, false);
+	}
+};
+
 #endif
@@ -14,13 +14,13 @@
 // VATA headers
 #include	<vata/vata.hh>
 
+// MTBDD headers (for NODE1MASK and NODE2MASK)
+#include "classify_case.hh"
+
 namespace VATA
 {
 	namespace MTBDDPkg
 	{
-		const char NODE1MASK = 0x01;  // 00000001
-		const char NODE2MASK = 0x02;  // 00000010
-
 		template <class Node1PtrType, class Node2PtrType>
 		char BoolClassifyCase(const Node1PtrType& node1,
 			const Node2PtrType& node2);
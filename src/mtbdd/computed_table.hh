@@ -0,0 +1,316 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Computed table (operation cache) shared by MTBDD apply functors
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_MTBDD_COMPUTED_TABLE_HH_
+#define _VATA_MTBDD_COMPUTED_TABLE_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "mtbdd_node.hh"
+
+
+namespace VATA
+{
+	namespace MTBDDPkg
+	{
+		class ComputedTable;
+	}
+}
+
+
+/**
+ * @brief  Computed table of MTBDD operations
+ *
+ * The table caches results of apply operations, keyed by an operation and its
+ * operand nodes, across calls of the operation. It has a fixed number of
+ * entries; an entry is simply overwritten by a newer result with the same
+ * hash, so the table is lossy and its memory is bounded.
+ *
+ * Nodes are recorded together with the generations of their arena slots (see
+ * NodeArena). An entry whose operand or result node has been reclaimed in the
+ * meantime therefore never matches, even if the slot has been reused by
+ * another node, and no explicit invalidation is needed.
+ *
+ * Like the unique tables, the computed table is kept per thread.
+ */
+class VATA::MTBDDPkg::ComputedTable
+{
+public:   // public data types
+
+	/**
+	 * @brief  Identifier of an operation
+	 */
+	typedef uint32_t OperationType;
+
+private:  // private data types
+
+	typedef uint32_t IndexType;
+	typedef uint32_t GenerationType;
+
+private:  // private constants
+
+	/**
+	 * @brief  Maximum arity of an operation
+	 */
+	static const size_t MAX_OPERANDS = 3;
+
+	/**
+	 * @brief  Position of the result in an entry
+	 */
+	static const size_t RESULT = MAX_OPERANDS;
+
+	/**
+	 * @brief  The number of entries of the table
+	 */
+	static const size_t SIZE = size_t(1) << 16;
+
+	/**
+	 * @brief  The operation of empty entries
+	 */
+	static const OperationType NO_OPERATION = 0;
+
+private:  // private data types
+
+	/**
+	 * @brief  Entry of the table
+	 *
+	 * The last node of the entry is the result, bit @p i of @p leafMask tells
+	 * whether the @p i-th node is a leaf.
+	 */
+	struct Entry
+	{
+		OperationType op;
+		uint32_t leafMask;
+		IndexType index[MAX_OPERANDS + 1];
+		GenerationType gen[MAX_OPERANDS + 1];
+	};
+
+private:  // private data members
+
+	std::vector<Entry> entries_;
+
+	size_t hits_;
+
+	size_t misses_;
+
+private:  // private methods
+
+	ComputedTable(const ComputedTable&);
+	ComputedTable& operator=(const ComputedTable&);
+
+	ComputedTable() :
+		entries_(),
+		hits_(0),
+		misses_(0)
+	{ }
+
+	static ComputedTable& instance()
+	{
+		static thread_local ComputedTable table;
+		return table;
+	}
+
+	template <class NodePtrType>
+	static GenerationType generation(bool leaf, IndexType index)
+	{
+		typedef typename NodePtrType::DataType DataType;
+
+		return (leaf)? LeafNode<DataType>::Arena().Generation(index)
+			: InternalNode<DataType>::Arena().Generation(index);
+	}
+
+	template <class NodePtrType>
+	static void setNode(Entry& entry, size_t pos, const NodePtrType& node)
+	{
+		assert(!IsNull(node));
+
+		bool leaf = IsLeaf(node);
+		entry.index[pos] = GetNodeIndex(node);
+		entry.gen[pos] = generation<NodePtrType>(leaf, entry.index[pos]);
+		entry.leafMask |= (leaf? 1U : 0U) << pos;
+	}
+
+	template <class... NodePtrTypes>
+	static Entry makeKey(OperationType op, const NodePtrTypes&... operands)
+	{
+		static_assert(sizeof...(operands) <= MAX_OPERANDS, "Too many operands");
+
+		Entry key = Entry();
+		key.op = op;
+
+		size_t pos = 0;
+		int expand[] = {(setNode(key, pos++, operands), 0)...};
+		(void)expand;
+
+		return key;
+	}
+
+	static size_t hash(const Entry& key)
+	{
+		uint64_t h = key.op;
+		for (size_t i = 0; i < MAX_OPERANDS; ++i)
+		{
+			h = h * 0x9e3779b97f4a7c15ULL + key.index[i];
+		}
+
+		h ^= key.leafMask;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+
+		return static_cast<size_t>(h);
+	}
+
+	static bool sameOperands(const Entry& lhs, const Entry& rhs)
+	{
+		const uint32_t operandMask = (1U << MAX_OPERANDS) - 1;
+
+		if ((lhs.op != rhs.op) ||
+			((lhs.leafMask & operandMask) != (rhs.leafMask & operandMask)))
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < MAX_OPERANDS; ++i)
+		{
+			if ((lhs.index[i] != rhs.index[i]) || (lhs.gen[i] != rhs.gen[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	Entry& slot(const Entry& key)
+	{
+		if (entries_.empty())
+		{	// the table is allocated on the first use
+			entries_.resize(SIZE, Entry());
+		}
+
+		return entries_[hash(key) & (SIZE - 1)];
+	}
+
+public:   // public methods
+
+	/**
+	 * @brief  Creates a new operation identifier
+	 *
+	 * Every operation whose results are stored in the table needs its own
+	 * identifier. The results of an operation must depend on its operands
+	 * only.
+	 *
+	 * @returns  A fresh operation identifier
+	 */
+	static OperationType NewOperation()
+	{
+		static std::atomic<OperationType> next(NO_OPERATION + 1);
+		return next++;
+	}
+
+	/**
+	 * @brief  Looks up a result
+	 *
+	 * @param[in]   op        The operation
+	 * @param[out]  result    The result (if found)
+	 * @param[in]   operands  The operand nodes
+	 *
+	 * @returns  @p true if the result was found
+	 */
+	template <
+		class NodeOutPtrType,
+		class... NodePtrTypes>
+	static bool Lookup(
+		OperationType                op,
+		NodeOutPtrType&              result,
+		const NodePtrTypes&...       operands)
+	{
+		ComputedTable& table = instance();
+
+		Entry key = makeKey(op, operands...);
+		const Entry& entry = table.slot(key);
+
+		if (sameOperands(entry, key))
+		{
+			bool leaf = (entry.leafMask >> RESULT) & 1;
+			if (entry.gen[RESULT] ==
+				generation<NodeOutPtrType>(leaf, entry.index[RESULT]))
+			{	// the result has not been reclaimed
+				result = (leaf)? GetLeafByIndex<NodeOutPtrType>(entry.index[RESULT])
+					: GetInternalByIndex<NodeOutPtrType>(entry.index[RESULT]);
+
+				++table.hits_;
+				return true;
+			}
+		}
+
+		++table.misses_;
+		return false;
+	}
+
+	/**
+	 * @brief  Stores a result
+	 *
+	 * @param[in]  op        The operation
+	 * @param[in]  result    The result
+	 * @param[in]  operands  The operand nodes
+	 */
+	template <
+		class NodeOutPtrType,
+		class... NodePtrTypes>
+	static void Insert(
+		OperationType                op,
+		const NodeOutPtrType&        result,
+		const NodePtrTypes&...       operands)
+	{
+		Entry key = makeKey(op, operands...);
+		setNode(key, RESULT, result);
+
+		instance().slot(key) = key;
+	}
+
+	/**
+	 * @brief  The number of successful lookups in the current thread
+	 */
+	static size_t GetHitCount()
+	{
+		return instance().hits_;
+	}
+
+	/**
+	 * @brief  The number of failed lookups in the current thread
+	 */
+	static size_t GetMissCount()
+	{
+		return instance().misses_;
+	}
+
+	/**
+	 * @brief  Removes all entries and resets the counters
+	 */
+	static void Clear()
+	{
+		ComputedTable& table = instance();
+
+		std::vector<Entry>().swap(table.entries_);
+		table.hits_ = 0;
+		table.misses_ = 0;
+	}
+};
+
+#endif
@@ -19,23 +19,12 @@
 #include	<cassert>
 #include	<stdint.h>
 
+#include "node_arena.hh"
+
 // Boost headers
 #include <boost/functional/hash.hpp>
 
 
-namespace
-{
-	template <
-		typename Data
-	>
-	struct InternalNode;
-
-	template <
-		typename Data
-	>
-	struct LeafNode;
-}
-
 namespace VATA
 {
 	namespace MTBDDPkg
@@ -44,6 +33,16 @@ namespace VATA
 			typename Data
 		>
 		struct MTBDDNodePtr;
+
+		template <
+			typename Data
+		>
+		struct InternalNode;
+
+		template <
+			typename Data
+		>
+		struct LeafNode;
 	}
 }
 
@@ -65,6 +64,9 @@ namespace VATA
  * Note that it <b>does not</b> count the <em>number of trees going through
  * the node</em>.
  *
+ * Nodes are allocated in per-thread arenas (see NodeArena), where every node
+ * is also identified by a 32-bit index.
+ *
  * @tparam  Data  The data type stored in leaves
  */
 template <
@@ -88,7 +90,14 @@ public:   // public data types
 	 *
 	 * The data type used for reference counter of MTBDD nodes.
 	 */
-	typedef uintptr_t RefCntType;
+	typedef uint32_t RefCntType;
+
+	/**
+	 * @brief  Index type
+	 *
+	 * The data type of indices of nodes in their arena.
+	 */
+	typedef uint32_t IndexType;
 
 	/**
 	 * @brief  Type of Boolean variables
@@ -412,6 +421,46 @@ public:
 	template <typename NodePtrType>
 	friend void DeleteInternalNode(NodePtrType node);
 
+	/**
+	 * @brief  Gets the index of a node
+	 *
+	 * Retrieves the index of the node (either internal or leaf) in the arena
+	 * of nodes of its kind.
+	 *
+	 * @param[in]  node  Pointer to the node
+	 *
+	 * @return  The index of the node
+	 *
+	 * @tparam  NodePtrType  Type of node pointer
+	 */
+	template <typename NodePtrType>
+	friend typename NodePtrType::IndexType GetNodeIndex(const NodePtrType& node);
+
+	/**
+	 * @brief  Gets a leaf node by its index
+	 *
+	 * @param[in]  index  Index of the leaf node in the arena of leaves
+	 *
+	 * @return  Pointer to the leaf node
+	 *
+	 * @tparam  NodePtrType  Type of node pointer
+	 */
+	template <typename NodePtrType>
+	friend NodePtrType GetLeafByIndex(typename NodePtrType::IndexType index);
+
+	/**
+	 * @brief  Gets an internal node by its index
+	 *
+	 * @param[in]  index  Index of the internal node in the arena of internal
+	 *                    nodes
+	 *
+	 * @return  Pointer to the internal node
+	 *
+	 * @tparam  NodePtrType  Type of node pointer
+	 */
+	template <typename NodePtrType>
+	friend NodePtrType GetInternalByIndex(typename NodePtrType::IndexType index);
+
 	/**
 	 * @brief  Checks if a node pointer is @p NULL
 	 *
@@ -639,7 +688,9 @@ public:
 };
 
 
-namespace
+namespace VATA
+{
+namespace MTBDDPkg
 {
 	/**
 	 * @brief  Internal MTBDD node
@@ -684,6 +735,20 @@ namespace
 		 */
 		typedef typename NodePtrType::VarType VarType;
 
+		/**
+		 * @brief  Index data type
+		 *
+		 * The data type of the index of the node in its arena.
+		 */
+		typedef typename NodePtrType::IndexType IndexType;
+
+		/**
+		 * @brief  Arena data type
+		 *
+		 * The data type of the arena the nodes are allocated in.
+		 */
+		typedef NodeArena<InternalNode> ArenaType;
+
 	private:  // private data members
 
 		/**
@@ -714,6 +779,13 @@ namespace
 		 */
 		RefCntType refcnt_;
 
+		/**
+		 * @brief  Index in the arena
+		 *
+		 * The index of the node in the arena of internal nodes.
+		 */
+		IndexType index_;
+
 	public:   // public methods
 
 		/**
@@ -721,18 +793,20 @@ namespace
 		 *
 		 * Constructs InternalNode from components.
 		 *
+		 * @param[in]  index   The node's index in the arena
 		 * @param[in]  low     The node's @e low child pointer
 		 * @param[in]  high    The node's @e high child pointer
 		 * @param[in]  var     The node's Boolean variable
 		 * @param[in]  refcnt  Value of reference counter
 		 */
 		GCC_DIAG_OFF(maybe-uninitialized)     // I know what I'm doing!!!
-		InternalNode(NodePtrType low, NodePtrType high, const VarType& var,
-			const RefCntType& refcnt) :
+		InternalNode(IndexType index, NodePtrType low, NodePtrType high,
+			const VarType& var, const RefCntType& refcnt) :
 			low_(low),
 			high_(high),
 			var_(var),
-			refcnt_(refcnt)
+			refcnt_(refcnt),
+			index_(index)
 		{
 			// Assertions
 			assert(!IsNull(low));
@@ -740,6 +814,31 @@ namespace
 		}
 		GCC_DIAG_ON(maybe-uninitialized)
 
+		/**
+		 * @brief  The arena of internal nodes
+		 *
+		 * Returns the arena of internal nodes of the current thread.
+		 *
+		 * @return  The arena
+		 */
+		static ArenaType& Arena()
+		{
+			static thread_local ArenaType arena;
+			return arena;
+		}
+
+		/**
+		 * @brief  Gets the node's index
+		 *
+		 * Returns the index of the node in the arena.
+		 *
+		 * @return  Index of the node
+		 */
+		inline const IndexType& GetIndex() const
+		{
+			return index_;
+		}
+
 		/**
 		 * @brief  Gets the node's variable
 		 *
@@ -854,6 +953,20 @@ namespace
 		 */
 		typedef typename NodePtr::RefCntType RefCntType;
 
+		/**
+		 * @brief  Data type of index
+		 *
+		 * The data type of the index of the leaf in its arena.
+		 */
+		typedef typename NodePtr::IndexType IndexType;
+
+		/**
+		 * @brief  Data type of arena
+		 *
+		 * The data type of the arena the leaves are allocated in.
+		 */
+		typedef NodeArena<LeafNode> ArenaType;
+
 	private:  // private data members
 
 		/**
@@ -870,6 +983,13 @@ namespace
 		 */
 		RefCntType refcnt_;
 
+		/**
+		 * @brief  Index in the arena
+		 *
+		 * The index of the leaf in the arena of leaves.
+		 */
+		IndexType index_;
+
 	public:   // public methods
 
 
@@ -878,14 +998,41 @@ namespace
 		 *
 		 * Constructs the leaf from components.
 		 *
+		 * @param[in]  index   The index in the arena
 		 * @param[in]  data    The data value
 		 * @param[in]  refcnt  The reference counter
 		 */
-		LeafNode(const DataType& data, const RefCntType& refcnt)
+		LeafNode(IndexType index, const DataType& data, const RefCntType& refcnt)
 			: data_(data),
-				refcnt_(refcnt)
+				refcnt_(refcnt),
+				index_(index)
 		{ }
 
+		/**
+		 * @brief  The arena of leaves
+		 *
+		 * Returns the arena of leaves of the current thread.
+		 *
+		 * @return  The arena
+		 */
+		static ArenaType& Arena()
+		{
+			static thread_local ArenaType arena;
+			return arena;
+		}
+
+		/**
+		 * @brief  Gets the leaf's index
+		 *
+		 * Returns the index of the leaf in the arena.
+		 *
+		 * @return  Index of the leaf
+		 */
+		inline const IndexType& GetIndex() const
+		{
+			return index_;
+		}
+
 		/**
 		 * @brief  Gets data from the leaf
 		 *
@@ -937,6 +1084,7 @@ namespace
 		}
 	};
 }
+}
 
 
 namespace VATA
@@ -1025,8 +1173,8 @@ namespace VATA
 			typedef MTBDDNodePtr<DataType> NodePtrType;
 			typedef typename NodePtrType::LeafType LeafType;
 
-			// TODO: create allocator
-			LeafType* newNode = new LeafType(data, 0);
+			typename LeafType::ArenaType& arena = LeafType::Arena();
+			LeafType* newNode = arena.Get(arena.Create(data, 0));
 
 			return NodePtrType::makeLeaf(newNode);
 		}
@@ -1041,8 +1189,8 @@ namespace VATA
 
 			typedef typename NodePtrType::InternalType InternalType;
 
-			// TODO: create allocator
-			InternalType* newNode = new InternalType(low, high, var, 0);
+			typename InternalType::ArenaType& arena = InternalType::Arena();
+			InternalType* newNode = arena.Get(arena.Create(low, high, var, 0));
 
 			return NodePtrType::makeInternal(newNode);
 		}
@@ -1129,7 +1277,9 @@ namespace VATA
 			assert(IsLeaf(node));
 			assert(GetLeafRefCnt(node) == 0);
 
-			delete NodePtrType::nodeToLeaf(node);
+			typedef typename NodePtrType::LeafType LeafType;
+
+			LeafType::Arena().Destroy(NodePtrType::nodeToLeaf(node)->GetIndex());
 		}
 
 		template <typename NodePtrType>
@@ -1140,7 +1290,42 @@ namespace VATA
 			assert(IsInternal(node));
 			assert(NodePtrType::getInternalRefCnt(node) == 0);
 
-			delete NodePtrType::nodeToInternal(node);
+			typedef typename NodePtrType::InternalType InternalType;
+
+			InternalType::Arena().Destroy(
+				NodePtrType::nodeToInternal(node)->GetIndex());
+		}
+
+		template <typename NodePtrType>
+		inline typename NodePtrType::IndexType GetNodeIndex(const NodePtrType& node)
+		{
+			// Assertions
+			assert(!IsNull(node));
+
+			if (IsLeaf(node))
+			{
+				return NodePtrType::nodeToLeaf(node)->GetIndex();
+			}
+			else
+			{	// for internal nodes
+				return NodePtrType::nodeToInternal(node)->GetIndex();
+			}
+		}
+
+		template <typename NodePtrType>
+		inline NodePtrType GetLeafByIndex(typename NodePtrType::IndexType index)
+		{
+			typedef typename NodePtrType::LeafType LeafType;
+
+			return NodePtrType::makeLeaf(LeafType::Arena().Get(index));
+		}
+
+		template <typename NodePtrType>
+		inline NodePtrType GetInternalByIndex(typename NodePtrType::IndexType index)
+		{
+			typedef typename NodePtrType::InternalType InternalType;
+
+			return NodePtrType::makeInternal(InternalType::Arena().Get(index));
 		}
 
 		template <typename NodePtrType>
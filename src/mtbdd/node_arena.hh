@@ -0,0 +1,221 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Arena allocator for the nodes of Ondrik's MTBDD
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_MTBDD_NODE_ARENA_HH_
+#define _VATA_MTBDD_NODE_ARENA_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace VATA
+{
+	namespace MTBDDPkg
+	{
+		template <
+			class Node
+		>
+		class NodeArena;
+	}
+}
+
+
+/**
+ * @brief  Arena of MTBDD nodes
+ *
+ * The arena stores nodes in chunks of a fixed size, so that the address of a
+ * node never changes, and identifies every node by a 32-bit index. Slots of
+ * destroyed nodes are kept in a free list and reused by subsequently created
+ * nodes, so the memory of the arena is only released when the arena itself is
+ * destroyed.
+ *
+ * Every slot also has a generation, which is incremented whenever the node in
+ * the slot is destroyed. A pair (index, generation) therefore identifies a
+ * node even after its slot has been reused.
+ *
+ * @tparam  Node  The type of nodes
+ */
+template <
+	class Node
+>
+class VATA::MTBDDPkg::NodeArena
+{
+public:   // public data types
+
+	/**
+	 * @brief  Index of a node in the arena
+	 */
+	typedef uint32_t IndexType;
+
+	/**
+	 * @brief  Generation of a slot
+	 */
+	typedef uint32_t GenerationType;
+
+private:  // private data types
+
+	typedef typename std::aligned_storage<sizeof(Node), alignof(Node)>::type
+		SlotType;
+
+private:  // private constants
+
+	static const size_t CHUNK_BITS = 12;
+	static const size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+
+private:  // private data members
+
+	/**
+	 * @brief  Chunks of slots
+	 */
+	std::vector<SlotType*> chunks_;
+
+	/**
+	 * @brief  Chunks of generations of slots
+	 */
+	std::vector<GenerationType*> generations_;
+
+	/**
+	 * @brief  The number of slots ever used
+	 */
+	IndexType used_;
+
+	/**
+	 * @brief  Indices of free slots below @p used_
+	 */
+	std::vector<IndexType> free_;
+
+private:  // private methods
+
+	NodeArena(const NodeArena&);
+	NodeArena& operator=(const NodeArena&);
+
+	SlotType* getSlot(IndexType index) const
+	{
+		assert(index < used_);
+
+		return &chunks_[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+	}
+
+public:   // public methods
+
+	NodeArena() :
+		chunks_(),
+		generations_(),
+		used_(0),
+		free_()
+	{ }
+
+	/**
+	 * @brief  Creates a node
+	 *
+	 * Constructs a node in a free slot of the arena. The index of the slot is
+	 * passed to the constructor of the node as its first argument, followed by
+	 * @p args.
+	 *
+	 * @returns  The index of the new node
+	 */
+	template <class... Args>
+	IndexType Create(Args&&... args)
+	{
+		IndexType index;
+		if (!free_.empty())
+		{	// reuse a slot of a destroyed node
+			index = free_.back();
+			free_.pop_back();
+		}
+		else
+		{
+			assert(used_ < std::numeric_limits<IndexType>::max());
+
+			if (used_ == chunks_.size() * CHUNK_SIZE)
+			{	// all chunks are full
+				chunks_.push_back(new SlotType[CHUNK_SIZE]);
+				generations_.push_back(new GenerationType[CHUNK_SIZE]());
+			}
+
+			index = used_++;
+		}
+
+		new (getSlot(index)) Node(index, std::forward<Args>(args)...);
+
+		return index;
+	}
+
+	/**
+	 * @brief  Destroys a node and releases its slot
+	 */
+	void Destroy(IndexType index)
+	{
+		Get(index)->~Node();
+		++generations_[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+		free_.push_back(index);
+	}
+
+	/**
+	 * @brief  The generation of a slot
+	 */
+	GenerationType Generation(IndexType index) const
+	{
+		assert(index < used_);
+
+		return generations_[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+	}
+
+	Node* Get(IndexType index) const
+	{
+		return reinterpret_cast<Node*>(getSlot(index));
+	}
+
+	/**
+	 * @brief  The number of nodes in the arena
+	 */
+	size_t Size() const
+	{
+		return used_ - free_.size();
+	}
+
+	~NodeArena()
+	{
+		std::vector<bool> isFree(used_, false);
+		for (IndexType index : free_)
+		{
+			isFree[index] = true;
+		}
+
+		for (IndexType index = 0; index < used_; ++index)
+		{
+			if (!isFree[index])
+			{
+				Get(index)->~Node();
+			}
+		}
+
+		for (SlotType* chunk : chunks_)
+		{
+			delete[] chunk;
+		}
+
+		for (GenerationType* chunk : generations_)
+		{
+			delete[] chunk;
+		}
+	}
+};
+
+#endif
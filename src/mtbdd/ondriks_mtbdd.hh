@@ -18,14 +18,17 @@
 #include  <vata/notimpl_except.hh>
 
 #include	"mtbdd_node.hh"
+#include	"unique_table.hh"
 
 // Standard library headers
+#include	<algorithm>
 #include	<cassert>
 #include	<stdint.h>
 #include	<stdexcept>
 #include	<vector>
 #include  <memory>
 #include  <unordered_map>
+#include  <unordered_set>
 
 // Boost library headers
 #include <boost/functional/hash.hpp>
@@ -51,6 +54,9 @@ namespace VATA
     template <class>
 	  class BoolApply2Functor;
 
+		template <class>
+		class AndExistsFunctor;
+
 		template <class, typename>
 		class VoidApply1Functor;
 
@@ -59,10 +65,57 @@ namespace VATA
 
 		template <class, typename, typename, typename>
 		class VoidApply3Functor;
+
+		class GarbageCollectionLock;
 	}
 }
 
 
+/**
+ * @brief  Postpones garbage collection of MTBDD nodes
+ *
+ * Nodes that are not referenced by any MTBDD are only reclaimed by the
+ * garbage collector of OndriksMTBDD. While an object of this class exists, no
+ * garbage is collected in the current thread, so that an operation may safely
+ * hold unreferenced nodes (e.g. partial results of an apply operation) while
+ * it runs code that might destroy MTBDDs.
+ */
+class VATA::MTBDDPkg::GarbageCollectionLock
+{
+private:  // private methods
+
+	GarbageCollectionLock(const GarbageCollectionLock&);
+	GarbageCollectionLock& operator=(const GarbageCollectionLock&);
+
+	static size_t& depth()
+	{
+		static thread_local size_t depth = 0;
+		return depth;
+	}
+
+public:   // public methods
+
+	GarbageCollectionLock()
+	{
+		++depth();
+	}
+
+	/**
+	 * @brief  Checks whether garbage collection is postponed
+	 */
+	static bool IsLocked()
+	{
+		return depth() > 0;
+	}
+
+	~GarbageCollectionLock()
+	{
+		assert(depth() > 0);
+		--depth();
+	}
+};
+
+
 /**
  * @brief   Class representing MTBDD
  *
@@ -88,6 +141,9 @@ class VATA::MTBDDPkg::OndriksMTBDD
 	template <class>
 	friend class BoolApply2Functor;
 
+	template <class>
+	friend class AndExistsFunctor;
+
 	template <class, typename>
 	friend class VoidApply1Functor;
 
@@ -111,29 +167,138 @@ public:   // public data types
 	typedef std::vector<VarType> PermutationTable;
 	typedef std::shared_ptr<PermutationTable> PermutationTablePtr;
 
-private:  // private data types
+	/**
+	 * @brief  A list of assignments with their values, see Build()
+	 */
+	typedef std::vector<std::pair<SymbolicVarAsgn, DataType>> AsgnValueList;
+
+	/**
+	 * @brief  The outcome of variable reordering
+	 *
+	 * @p permutation maps every variable of the original order to its new
+	 * position.
+	 */
+	struct ReorderingResult
+	{
+		size_t nodesBefore;
+		size_t nodesAfter;
+		PermutationTablePtr permutation;
+	};
+
+	/**
+	 * @brief  A node of an MTBDD exported by Export()
+	 *
+	 * The children of an internal node are given by their positions in
+	 * ExportedMTBDD::nodes; a leaf gives the position of its value in
+	 * ExportedMTBDD::leaves in @p low.
+	 */
+	struct ExportedNode
+	{
+		bool isLeaf;
+		VarType var;
+		size_t low;
+		size_t high;
+	};
 
-	typedef VATA::Util::Triple<NodePtrType, NodePtrType, VarType>
-		InternalAddressType;
+	/**
+	 * @brief  An MTBDD detached from the tables of nodes
+	 *
+	 * Unlike an MTBDD, this structure may be passed to another thread and
+	 * imported there using Import(). Every node precedes its parents, the root
+	 * is the last node.
+	 *
+	 * @tparam  ExportedData  The type the leaves are exported to
+	 */
+	template <class ExportedData>
+	struct ExportedMTBDD
+	{
+		std::vector<ExportedNode> nodes;
+		std::vector<ExportedData> leaves;
+		ExportedData defaultValue;
+
+		ExportedMTBDD() :
+			nodes(),
+			leaves(),
+			defaultValue()
+		{ }
+	};
 
-	typedef std::unordered_map<InternalAddressType, NodePtrType,
-		boost::hash<InternalAddressType>> InternalCacheType;
+private:  // private data types
 
-	typedef std::unordered_map<DataType, NodePtrType,
-		boost::hash<DataType>> LeafCacheType;
+	typedef typename NodePtrType::IndexType IndexType;
 
 	typedef VATA::Util::Convert Convert;
 
 	typedef std::unordered_set<NodePtrType, boost::hash<NodePtrType>> NodePtrSet;
 
+	typedef std::unordered_map<NodePtrType, size_t,
+		boost::hash<NodePtrType>> NodePositionMap;
+
+	typedef std::unordered_map<NodePtrType, NodePtrType,
+		boost::hash<NodePtrType>> PermuteCache;
+
+	typedef VATA::Util::Triple<VarType, NodePtrType, NodePtrType> IteKey;
+
+	typedef std::unordered_map<IteKey, NodePtrType, boost::hash<IteKey>>
+		IteCache;
+
+	typedef std::pair<VarType, std::vector<size_t>> BuildKey;
+
+	typedef std::unordered_map<BuildKey, NodePtrType, boost::hash<BuildKey>>
+		BuildCache;
+
+	typedef std::pair<NodePtrType, size_t> InsertKey;
+
+	typedef std::unordered_map<InsertKey, NodePtrType, boost::hash<InsertKey>>
+		InsertCache;
+
+private:  // private constants
+
+	static const size_t DEFAULT_GC_THRESHOLD = size_t(1) << 14;
+
+	/**
+	 * @brief  Growth allowed while sifting a variable, in percents
+	 *
+	 * A variable is not moved further in a direction once the MTBDDs have
+	 * grown by more than this bound over the best size seen.
+	 */
+	static const size_t SIFTING_MAX_GROWTH = 120;
+
+	/**
+	 * @brief  Nodes per assignment and variable the bulk build may create
+	 *
+	 * See buildNode().
+	 */
+	static const size_t BUILD_BUDGET_FACTOR = 4;
+
 private:  // private data members
 
 	NodePtrType root_;
 
 	DataType defaultValue_;
 
-	static LeafCacheType leafCache_;
-	static InternalCacheType internalCache_;
+	/**
+	 * @brief  Unique tables of nodes
+	 *
+	 * The tables are kept per thread (as well as the arenas of nodes), so that
+	 * threads working with independent MTBDDs do not need any
+	 * synchronisation. An MTBDD therefore must not be passed to another
+	 * thread.
+	 */
+	static thread_local UniqueTable leafTable_;
+	static thread_local UniqueTable internalTable_;
+
+	/**
+	 * @brief  The number of nodes that lost their last reference
+	 *
+	 * A node whose reference count drops to zero is not reclaimed immediately;
+	 * it stays in the unique table, so that it may be reused by subsequent
+	 * operations. When the number of such nodes reaches @p gcThreshold_, all
+	 * nodes that are not referenced are reclaimed in bulk by collectGarbage().
+	 */
+	static thread_local size_t deadCount_;
+
+	static thread_local size_t gcThreshold_;
 
 
 private:  // private methods
@@ -223,13 +388,28 @@ private:  // private methods
 		return root_;
 	}
 
+	static size_t hashLeaf(const DataType& data)
+	{
+		return boost::hash<DataType>()(data);
+	}
+
+	static size_t hashInternal(
+		const NodePtrType& low, const NodePtrType& high, const VarType& var)
+	{
+		size_t seed = 0;
+		boost::hash_combine(seed, low);
+		boost::hash_combine(seed, high);
+		boost::hash_combine(seed, var);
+		return seed;
+	}
+
 	static void disposeOfLeafNode(NodePtrType node)
 	{
 		// Assertions
 		assert(!IsNull(node));
 		assert(IsLeaf(node));
 
-		if (leafCache_.erase(GetDataFromLeaf(node)) != 1)
+		if (!leafTable_.Erase(hashLeaf(GetDataFromLeaf(node)), GetNodeIndex(node)))
 		{	// in case the leaf was not cached
 			assert(false);     // fail gracefully
 		}
@@ -243,89 +423,163 @@ private:  // private methods
 		assert(!IsNull(node));
 		assert(IsInternal(node));
 
-		InternalAddressType addr(GetLowFromInternal(node),
+		size_t hash = hashInternal(GetLowFromInternal(node),
 			GetHighFromInternal(node), GetVarFromInternal(node));
-		if (internalCache_.erase(addr) != 1)
+		if (!internalTable_.Erase(hash, GetNodeIndex(node)))
 		{	// in case the internal was not cached
 			assert(false);   // fail gracefully
 		}
 
-		recursivelyDeleteMTBDDNode(GetLowFromInternal(node));
-		recursivelyDeleteMTBDDNode(GetHighFromInternal(node));
-
 		DeleteInternalNode(node);
 	}
 
-	static void recursivelyDeleteMTBDDNode(NodePtrType node)
+	/**
+	 * @brief  Releases a reference to a node
+	 *
+	 * The node is not reclaimed even if the reference is the last one, it is
+	 * only counted as possible garbage.
+	 *
+	 * @returns  @p true if the reference was the last one
+	 */
+	static bool releaseNode(NodePtrType node)
 	{
 		// Assertions
 		assert(!IsNull(node));
 
-		if (IsLeaf(node))
-		{	// for leaves
-			if (DecrementLeafRefCnt(node) == 0)
-			{	// this reference to node is the last
-				disposeOfLeafNode(node);
-			}
+		if ((IsLeaf(node))? DecrementLeafRefCnt(node) == 0
+			: DecrementInternalRefCnt(node) == 0)
+		{	// this reference to node is the last
+			++deadCount_;
+			return true;
 		}
-		else
-		{	// for internal nodes
-			assert(IsInternal(node));
 
-			if (DecrementInternalRefCnt(node) == 0)
-			{	// this reference to node is the last
+		return false;
+	}
+
+	/**
+	 * @brief  Reclaims all nodes that are not referenced
+	 *
+	 * Sweeps the unique tables for nodes with no references, including the
+	 * nodes that have never been referenced (such as discarded partial results
+	 * of operations). Releasing the successors of reclaimed nodes may make
+	 * further nodes garbage; they are processed in the same run, using an
+	 * explicit stack instead of recursion.
+	 */
+	static void collectGarbage()
+	{
+		std::vector<NodePtrType> stack;
+
+		leafTable_.ForEach([&stack](IndexType index)
+			{
+				NodePtrType node = GetLeafByIndex<NodePtrType>(index);
+				if (GetLeafRefCnt(node) == 0)
+				{
+					stack.push_back(node);
+				}
+			});
+
+		internalTable_.ForEach([&stack](IndexType index)
+			{
+				NodePtrType node = GetInternalByIndex<NodePtrType>(index);
+				if (GetRefCnt(node) == 0)
+				{
+					stack.push_back(node);
+				}
+			});
+
+		while (!stack.empty())
+		{
+			NodePtrType node = stack.back();
+			stack.pop_back();
+
+			if (IsLeaf(node))
+			{	// for leaves
+				disposeOfLeafNode(node);
+			}
+			else
+			{	// for internal nodes
+				NodePtrType low = GetLowFromInternal(node);
+				NodePtrType high = GetHighFromInternal(node);
 				disposeOfInternalNode(node);
+
+				if (releaseNode(low))
+				{	// the reference to the successor was the last
+					stack.push_back(low);
+				}
+
+				if (releaseNode(high))
+				{	// the reference to the successor was the last
+					stack.push_back(high);
+				}
 			}
 		}
+
+		deadCount_ = 0;
 	}
 
 	inline void deleteMTBDD()
 	{
 		if (!IsNull(root_))
 		{
-			recursivelyDeleteMTBDDNode(root_);
+			releaseNode(root_);
 			root_ = 0;
+
+			if ((deadCount_ >= gcThreshold_) &&
+				!GarbageCollectionLock::IsLocked())
+			{	// there is enough garbage
+				collectGarbage();
+			}
 		}
 	}
 
-	// TODO: optimize
 	static inline NodePtrType spawnLeaf(const DataType& data)
 	{
 		NodePtrType result = 0;
 
-		typename LeafCacheType::const_iterator itLC;
-		if ((itLC = leafCache_.find(data)) != leafCache_.end())
+		size_t hash = hashLeaf(data);
+		IndexType index = leafTable_.Find(hash, [&data](IndexType i)
+			{
+				return GetDataFromLeaf(GetLeafByIndex<NodePtrType>(i)) == data;
+			});
+
+		if (UniqueTable::NOT_FOUND != index)
 		{	// in case given leaf is already cached
-			result = itLC->second;
+			result = GetLeafByIndex<NodePtrType>(index);
 		}
 		else
 		{	// if the leaf doesn't exist
 			result = CreateLeaf(data);
-			leafCache_.insert(std::make_pair(data, result));
+			leafTable_.Insert(hash, GetNodeIndex(result));
 		}
 
 		assert(!IsNull(result));
 		return result;
 	}
 
-	// TODO: optimize
 	static inline NodePtrType spawnInternal(
 		NodePtrType low, NodePtrType high, const VarType& var)
 	{
 		NodePtrType result = 0;
 
-		InternalAddressType addr(low, high, var);
-		typename InternalCacheType::const_iterator itIC;
-		if ((itIC = internalCache_.find(addr)) != internalCache_.end())
+		size_t hash = hashInternal(low, high, var);
+		IndexType index = internalTable_.Find(hash, [&low, &high, &var](IndexType i)
+			{
+				NodePtrType node = GetInternalByIndex<NodePtrType>(i);
+				return (GetVarFromInternal(node) == var) &&
+					(GetLowFromInternal(node) == low) &&
+					(GetHighFromInternal(node) == high);
+			});
+
+		if (UniqueTable::NOT_FOUND != index)
 		{	// in case given internal is already cached
-			result = itIC->second;
+			result = GetInternalByIndex<NodePtrType>(index);
 		}
 		else
 		{	// if the internal doesn't exist
 			result = CreateInternal(low, high, var);
 			IncrementRefCnt(low);
 			IncrementRefCnt(high);
-			internalCache_.insert(std::make_pair(addr, result));
+			internalTable_.Insert(hash, GetNodeIndex(result));
 		}
 
 		assert(!IsNull(result));
@@ -463,17 +717,370 @@ private:  // private methods
 		return result;
 	}
 
+	/**
+	 * @brief  Creates a node branching on a variable
+	 *
+	 * Creates the node for "if @p var then @p high else @p low", where @p high
+	 * and @p low may contain variables greater than @p var, i.e., @p var is
+	 * inserted to its place in the ordering.
+	 */
+	static NodePtrType iteNode(
+		const VarType&                var,
+		const NodePtrType&            high,
+		const NodePtrType&            low,
+		IteCache&                     cache)
+	{
+		if (high == low)
+		{	// the variable is redundant
+			return low;
+		}
+
+		bool highBelow = IsLeaf(high) || (GetVarFromInternal(high) < var);
+		bool lowBelow = IsLeaf(low) || (GetVarFromInternal(low) < var);
+		if (highBelow && lowBelow)
+		{	// var goes on the top
+			return spawnInternal(low, high, var);
+		}
+
+		IteKey key(var, high, low);
+		typename IteCache::const_iterator itCache = cache.find(key);
+		if (itCache != cache.end())
+		{
+			return itCache->second;
+		}
+
+		VarType top = (highBelow)? GetVarFromInternal(low)
+			: ((lowBelow)? GetVarFromInternal(high)
+			: std::max(GetVarFromInternal(high), GetVarFromInternal(low)));
+		assert(top > var);
+
+		NodePtrType high0 = high;
+		NodePtrType high1 = high;
+		if (!highBelow && (GetVarFromInternal(high) == top))
+		{
+			high0 = GetLowFromInternal(high);
+			high1 = GetHighFromInternal(high);
+		}
+
+		NodePtrType low0 = low;
+		NodePtrType low1 = low;
+		if (!lowBelow && (GetVarFromInternal(low) == top))
+		{
+			low0 = GetLowFromInternal(low);
+			low1 = GetHighFromInternal(low);
+		}
+
+		NodePtrType lowTree = iteNode(var, high0, low0, cache);
+		NodePtrType highTree = iteNode(var, high1, low1, cache);
+
+		NodePtrType result = (lowTree == highTree)? lowTree
+			: spawnInternal(lowTree, highTree, top);
+
+		cache.insert(std::make_pair(key, result));
+		return result;
+	}
+
+	static NodePtrType permuteNode(
+		const NodePtrType             node,
+		const PermutationTable&       perm,
+		const VarType&                lowest,
+		PermuteCache&                 cache,
+		IteCache&                     iteCache)
+	{
+		assert(!IsNull(node));
+
+		if (IsLeaf(node) || (GetVarFromInternal(node) < lowest))
+		{	// nodes below the lowest permuted variable are not changed
+			return node;
+		}
+
+		typename PermuteCache::const_iterator itCache = cache.find(node);
+		if (itCache != cache.end())
+		{
+			return itCache->second;
+		}
+
+		VarType var = GetVarFromInternal(node);
+		NodePtrType lowTree = permuteNode(GetLowFromInternal(node), perm, lowest,
+			cache, iteCache);
+		NodePtrType highTree = permuteNode(GetHighFromInternal(node), perm,
+			lowest, cache, iteCache);
+
+		NodePtrType result = iteNode((var < perm.size())? perm[var] : var,
+			highTree, lowTree, iteCache);
+
+		cache.insert(std::make_pair(node, result));
+		return result;
+	}
+
+	/**
+	 * @brief  Builds the node for assignments with the given indices
+	 *
+	 * The assignments are split according to the top variable (an assignment
+	 * with a don't care goes to both parts) and the parts are processed
+	 * recursively for the rest of the variables. Nodes are memoised by the
+	 * variable and the indices, so that parts that meet again after a don't
+	 * care are built only once.
+	 *
+	 * Assignments with don't cares at different positions may still yield
+	 * exponentially many distinct parts. Every node that is not found in the
+	 * cache therefore consumes @p budget; once it is exhausted, the build is
+	 * abandoned and a null node is returned.
+	 *
+	 * @param[in]      varCnt  The number of variables below the built node
+	 * @param[in,out]  budget  The number of nodes that may still be built
+	 */
+	template <class MergeFunc>
+	static NodePtrType buildNode(
+		const AsgnValueList&              asgnValueList,
+		const std::vector<size_t>&        indices,
+		size_t                            varCnt,
+		const DataType&                   defaultValue,
+		MergeFunc&                        mergeFunc,
+		BuildCache&                       cache,
+		size_t&                           budget)
+	{
+		if (indices.empty())
+		{	// no assignment leads here
+			return spawnLeaf(defaultValue);
+		}
+
+		if (0 == varCnt)
+		{	// all variables are processed, merge the values
+			DataType value = defaultValue;
+			for (size_t index : indices)
+			{
+				value = mergeFunc(value, asgnValueList[index].second);
+			}
+
+			return spawnLeaf(value);
+		}
+
+		VarType var = varCnt - 1;
+
+		BuildKey key(var, indices);
+		typename BuildCache::const_iterator itCache = cache.find(key);
+		if (itCache != cache.end())
+		{
+			return itCache->second;
+		}
+
+		if (0 == budget)
+		{	// give up
+			return NodePtrType(static_cast<uintptr_t>(0));
+		}
+
+		--budget;
+
+		std::vector<size_t> lowIndices;
+		std::vector<size_t> highIndices;
+		bool isDontCare = true;
+		for (size_t index : indices)
+		{
+			const SymbolicVarAsgn& asgn = asgnValueList[index].first;
+			char value = (var < asgn.length())? asgn.GetIthVariableValue(var)
+				: static_cast<char>(SymbolicVarAsgn::DONT_CARE);
+
+			if (SymbolicVarAsgn::ONE != value)
+			{
+				lowIndices.push_back(index);
+			}
+
+			if (SymbolicVarAsgn::ZERO != value)
+			{
+				highIndices.push_back(index);
+			}
+
+			isDontCare = isDontCare && (SymbolicVarAsgn::DONT_CARE == value);
+		}
+
+		NodePtrType result(static_cast<uintptr_t>(0));
+		if (isDontCare)
+		{	// no assignment depends on the variable
+			result = buildNode(asgnValueList, indices, var, defaultValue, mergeFunc,
+				cache, budget);
+		}
+		else
+		{
+			NodePtrType low = buildNode(asgnValueList, lowIndices, var, defaultValue,
+				mergeFunc, cache, budget);
+			if (IsNull(low))
+			{
+				return low;
+			}
+
+			NodePtrType high = buildNode(asgnValueList, highIndices, var,
+				defaultValue, mergeFunc, cache, budget);
+			if (IsNull(high))
+			{
+				return high;
+			}
+
+			result = (low == high)? low : spawnInternal(low, high, var);
+		}
+
+		if (!IsNull(result))
+		{
+			cache.insert(std::make_pair(std::move(key), result));
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief  Merges a value into the leaves matching an assignment
+	 *
+	 * Returns the node in which every leaf reachable from @p node using @p asgn
+	 * is merged with @p value (the other leaves are kept). This is the union
+	 * with a single-path MTBDD, used by Build() if the bulk build gives up.
+	 *
+	 * @param[in]  varCnt  The number of variables below the node
+	 */
+	template <class MergeFunc>
+	static NodePtrType insertPath(
+		const NodePtrType&                node,
+		const SymbolicVarAsgn&            asgn,
+		size_t                            varCnt,
+		const DataType&                   value,
+		MergeFunc&                        mergeFunc,
+		InsertCache&                      cache)
+	{
+		if (0 == varCnt)
+		{	// all variables are processed
+			assert(IsLeaf(node));
+
+			return spawnLeaf(mergeFunc(GetDataFromLeaf(node), value));
+		}
+
+		InsertKey key(node, varCnt);
+		typename InsertCache::const_iterator itCache = cache.find(key);
+		if (itCache != cache.end())
+		{
+			return itCache->second;
+		}
+
+		VarType var = varCnt - 1;
+		char asgnValue = (var < asgn.length())? asgn.GetIthVariableValue(var)
+			: static_cast<char>(SymbolicVarAsgn::DONT_CARE);
+
+		NodePtrType low = node;
+		NodePtrType high = node;
+		if (IsInternal(node) && (GetVarFromInternal(node) == var))
+		{
+			low = GetLowFromInternal(node);
+			high = GetHighFromInternal(node);
+		}
+
+		if (SymbolicVarAsgn::ONE != asgnValue)
+		{
+			low = insertPath(low, asgn, var, value, mergeFunc, cache);
+		}
+
+		if (SymbolicVarAsgn::ZERO != asgnValue)
+		{
+			high = (SymbolicVarAsgn::DONT_CARE == asgnValue) && (high == node)?
+				low : insertPath(high, asgn, var, value, mergeFunc, cache);
+		}
+
+		NodePtrType result = (low == high)? low : spawnInternal(low, high, var);
+
+		cache.insert(std::make_pair(key, result));
+		return result;
+	}
+
+	template <
+		class ExportedData,
+		class ExportFunc>
+	static size_t exportNode(
+		const NodePtrType&                node,
+		ExportedMTBDD<ExportedData>&      exported,
+		NodePositionMap&                  positions,
+		ExportFunc&                       exportFunc)
+	{
+		auto itPos = positions.find(node);
+		if (positions.end() != itPos)
+		{	// the node has already been exported
+			return itPos->second;
+		}
+
+		ExportedNode exportedNode;
+		if (IsLeaf(node))
+		{
+			exportedNode.isLeaf = true;
+			exportedNode.var = 0;
+			exportedNode.low = exported.leaves.size();
+			exportedNode.high = 0;
+			exported.leaves.push_back(exportFunc(GetDataFromLeaf(node)));
+		}
+		else
+		{
+			exportedNode.isLeaf = false;
+			exportedNode.var = GetVarFromInternal(node);
+			exportedNode.low = exportNode(GetLowFromInternal(node), exported,
+				positions, exportFunc);
+			exportedNode.high = exportNode(GetHighFromInternal(node), exported,
+				positions, exportFunc);
+		}
+
+		size_t position = exported.nodes.size();
+		exported.nodes.push_back(exportedNode);
+		positions.insert(std::make_pair(node, position));
+
+		return position;
+	}
+
+	static void collectNodes(const NodePtrType& node, NodePtrSet& nodes)
+	{
+		if (!nodes.insert(node).second)
+		{	// the node has been visited
+			return;
+		}
+
+		if (IsInternal(node))
+		{
+			collectNodes(GetLowFromInternal(node), nodes);
+			collectNodes(GetHighFromInternal(node), nodes);
+		}
+	}
+
+	/**
+	 * @brief  Swaps two adjacent variables in a set of MTBDDs
+	 *
+	 * @returns  The number of nodes of the MTBDDs after the swap
+	 */
+	static size_t swapAdjacentVariables(
+		const std::vector<OndriksMTBDD*>&     mtbdds,
+		const VarType&                        var)
+	{
+		PermutationTable perm(var + 2);
+		for (VarType i = 0; i < perm.size(); ++i)
+		{
+			perm[i] = i;
+		}
+
+		std::swap(perm[var], perm[var + 1]);
+
+		for (OndriksMTBDD* bdd : mtbdds)
+		{
+			*bdd = bdd->Permute(perm);
+		}
+
+		return CountNodes(
+			std::vector<const OndriksMTBDD*>(mtbdds.begin(), mtbdds.end()));
+	}
+
   /**
-   * @brief  Recursive traverse of mtbdd to obtain all assignments
+   * @brief  Recursive traverse of mtbdd to visit all assignments
    *
-   * @param[in]  node  Node to traverse
-   * @param[in]  asgn  Assignment to be completed by traverse
-   * @param[out]  vec  Vector to be filled with assignments
+   * @param[in]      node     Node to traverse
+   * @param[in]      asgn     Assignment to be completed by traverse
+   * @param[in,out]  visitor  Functor called on every assignment
    */
+  template <class Visitor>
   void RecTraverse(
     const NodePtrType & node,
     SymbolicVarAsgn & asgn,
-    SymbolicVarAsgn::AssignmentList & vec
+    Visitor & visitor
   ) const
   {
     assert(!IsNull(node));
@@ -485,11 +1092,11 @@ private:  // private methods
 
       // low successor
       asgn.SetIthVariableValue(var, SymbolicVarAsgn::ZERO);
-      RecTraverse(GetLowFromInternal(node), asgn, vec);
+      RecTraverse(GetLowFromInternal(node), asgn, visitor);
 
       // high successor
       asgn.SetIthVariableValue(var, SymbolicVarAsgn::ONE);
-      RecTraverse(GetHighFromInternal(node), asgn, vec);
+      RecTraverse(GetHighFromInternal(node), asgn, visitor);
 
       // recursive patch
       asgn.SetIthVariableValue(var, SymbolicVarAsgn::DONT_CARE);
@@ -501,7 +1108,7 @@ private:  // private methods
 
       if (GetDataFromLeaf(node) != this->GetDefaultValue())
       { // valid assignment
-        vec.push_back(asgn);
+        visitor(static_cast<const SymbolicVarAsgn &>(asgn));
       }
     }
   }
@@ -562,10 +1169,11 @@ public:   // public methods
 		if (&mtbdd == this)
 			return *this;
 
+		// the new root is referenced first, so that it is not collected
+		IncrementRefCnt(mtbdd.root_);
 		deleteMTBDD();
 
 		root_ = mtbdd.root_;
-		IncrementRefCnt(root_);
 
 		defaultValue_ = mtbdd.defaultValue_;
 
@@ -639,6 +1247,131 @@ public:   // public methods
 		return GetDataFromLeaf(node);
 	}
 
+	/**
+	 * @brief  Exports the MTBDD so that it can be imported by another thread
+	 *
+	 * @param[in]  exportFunc  Function converting a leaf value to the exported
+	 *                         one (e.g. from data of the current thread)
+	 *
+	 * @returns  The exported MTBDD
+	 *
+	 * @see  Import()
+	 */
+	template <
+		class ExportedData,
+		class ExportFunc>
+	ExportedMTBDD<ExportedData> Export(
+		ExportFunc                       exportFunc) const
+	{
+		ExportedMTBDD<ExportedData> result;
+		NodePositionMap positions;
+
+		exportNode(root_, result, positions, exportFunc);
+		result.defaultValue = exportFunc(defaultValue_);
+
+		return result;
+	}
+
+	/**
+	 * @brief  Creates an MTBDD from an exported one
+	 *
+	 * The nodes of the MTBDD are created in the tables of the calling thread.
+	 *
+	 * @param[in]  exported    The MTBDD exported by Export()
+	 * @param[in]  importFunc  Function converting an exported leaf value back
+	 *
+	 * @returns  The MTBDD
+	 */
+	template <
+		class ExportedData,
+		class ImportFunc>
+	static OndriksMTBDD Import(
+		const ExportedMTBDD<ExportedData>&   exported,
+		ImportFunc                           importFunc)
+	{
+		// Assertions
+		assert(!exported.nodes.empty());
+
+		GarbageCollectionLock lock;
+
+		std::vector<NodePtrType> nodes;
+		nodes.reserve(exported.nodes.size());
+		for (const ExportedNode& node : exported.nodes)
+		{
+			if (node.isLeaf)
+			{
+				nodes.push_back(spawnLeaf(importFunc(exported.leaves[node.low])));
+			}
+			else
+			{
+				assert((node.low < nodes.size()) && (node.high < nodes.size()));
+				nodes.push_back(spawnInternal(nodes[node.low], nodes[node.high],
+					node.var));
+			}
+		}
+
+		NodePtrType root = nodes.back();
+		IncrementRefCnt(root);
+
+		return OndriksMTBDD(root, importFunc(exported.defaultValue));
+	}
+
+	/**
+	 * @brief  Builds an MTBDD from many assignments at once
+	 *
+	 * Every assignment (of the Boolean variables) is mapped to @p defaultValue
+	 * merged with the values of all assignments of @p asgnValueList that match
+	 * it, in the order of the list, i.e., the result is the same as uniting the
+	 * single-path MTBDDs of the list using @p mergeFunc. The MTBDD is, however,
+	 * built in a single bottom-up pass: the list is partitioned by the values
+	 * of the variables from the top one, so that no apply operation is
+	 * performed and every node is created only once.
+	 *
+	 * @param[in]  asgnValueList  The assignments with their values
+	 * @param[in]  defaultValue   The value of the assignments not in the list
+	 * @param[in]  mergeFunc      Binary function merging two values
+	 *
+	 * @returns  The MTBDD
+	 */
+	template <class MergeFunc>
+	static OndriksMTBDD Build(
+		const AsgnValueList&             asgnValueList,
+		const DataType&                  defaultValue,
+		MergeFunc                        mergeFunc)
+	{
+		size_t varCnt = 0;
+		std::vector<size_t> indices(asgnValueList.size());
+		for (size_t i = 0; i < asgnValueList.size(); ++i)
+		{
+			indices[i] = i;
+			varCnt = std::max(varCnt, asgnValueList[i].first.length());
+		}
+
+		GarbageCollectionLock lock;
+
+		// without don't cares, every assignment contributes at most varCnt nodes
+		BuildCache cache;
+		size_t budget = BUILD_BUDGET_FACTOR * (asgnValueList.size() + 1) *
+			(varCnt + 1);
+
+		NodePtrType root = buildNode(asgnValueList, indices, varCnt, defaultValue,
+			mergeFunc, cache, budget);
+		if (IsNull(root))
+		{	// in case the bulk build gave up, unite the paths one by one
+			root = spawnLeaf(defaultValue);
+			for (const auto& asgnValuePair : asgnValueList)
+			{
+				InsertCache insertCache;
+				root = insertPath(root, asgnValuePair.first, varCnt,
+					asgnValuePair.second, mergeFunc, insertCache);
+			}
+		}
+
+		IncrementRefCnt(root);
+
+		return OndriksMTBDD(root, defaultValue);
+	}
+
 	static std::string DumpToDot(
 		const std::vector<const OndriksMTBDD*>&           mtbdds)
 	{
@@ -708,26 +1441,49 @@ public:   // public methods
    * @return  List of assignments
    */
   SymbolicVarAsgn::AssignmentList GetAllAssignments() const
+  {
+    // result vector
+    SymbolicVarAsgn::AssignmentList vec;
+
+    ForEachAssignment([&vec](const SymbolicVarAsgn & asgn){
+      vec.push_back(asgn);
+    });
+
+    return vec;
+  }
+
+  /**
+   * @brief  Visits all assignments
+   *
+   * Walks the paths from the root to the leaves that differ from the default
+   * value and calls @p visitor on the assignment of each path, without
+   * collecting them. Variables that are not tested on a path are
+   * DONT_CARE. The assignment passed to @p visitor is valid during the call
+   * only.
+   *
+   * @param[in]  visitor  Functor called on every assignment
+   * @param[in]  vars     Minimal number of variables in assignments
+   */
+  template <class Visitor>
+  void ForEachAssignment(
+    Visitor visitor,
+    const size_t & vars = 0
+  ) const
   {
     assert(!IsNull(this->getRoot()));
 
     // number of variables in assignments
-    VarType vars = 1;
+    size_t length = 1;
     if (IsInternal(this->getRoot()))
     {
-      vars += GetVarFromInternal(this->getRoot());
+      length += GetVarFromInternal(this->getRoot());
     }
 
     // assignment with DONT_CARE variables
-    SymbolicVarAsgn asgn = SymbolicVarAsgn(vars);
-
-    // result vector
-    SymbolicVarAsgn::AssignmentList vec;
+    SymbolicVarAsgn asgn = SymbolicVarAsgn(std::max(length, vars));
 
     // recursive traverse
-    RecTraverse(this->getRoot(), asgn, vec);
-
-    return vec;
+    RecTraverse(this->getRoot(), asgn, visitor);
   }
 
 	/**
@@ -754,6 +1510,7 @@ public:   // public methods
 	{
 		assert(!IsNull(this->getRoot()));
 
+		GarbageCollectionLock lock;
 		NodePtrType newRoot = OndriksMTBDD::projectNode(
 			this->getRoot(), pred, applyFunc, this->GetDefaultValue());
 		IncrementRefCnt(newRoot);
@@ -782,6 +1539,7 @@ public:   // public methods
 	{
 		assert(!IsNull(this->getRoot()));
 
+		GarbageCollectionLock lock;
 		NodePtrType newRoot = OndriksMTBDD::renameNode(
 			this->getRoot(), renamer);
 		IncrementRefCnt(newRoot);
@@ -789,6 +1547,269 @@ public:   // public methods
 	}
 
 
+	/**
+	 * @brief  Permute variables
+	 *
+	 * Unlike Rename(), the permutation need not respect the ordering of
+	 * variables; the MTBDD is rebuilt so that variable @p v of @p this becomes
+	 * variable @p perm[v] of the result. Variables not covered by @p perm are
+	 * kept.
+	 *
+	 * @param[in]  perm  A permutation of variables
+	 *
+	 * @returns  An MTBDD with permuted variables
+	 */
+	OndriksMTBDD Permute(
+		const PermutationTable&  perm) const
+	{
+		assert(!IsNull(this->getRoot()));
+
+		VarType lowest = 0;
+		while ((lowest < perm.size()) && (perm[lowest] == lowest))
+		{	// find the lowest variable that is moved
+			++lowest;
+		}
+
+		GarbageCollectionLock lock;
+		PermuteCache cache;
+		IteCache iteCache;
+		NodePtrType newRoot = OndriksMTBDD::permuteNode(
+			this->getRoot(), perm, lowest, cache, iteCache);
+		IncrementRefCnt(newRoot);
+		return OndriksMTBDD(newRoot, this->GetDefaultValue());
+	}
+
+
+	/**
+	 * @brief  Permute a variable assignment
+	 *
+	 * Translates an assignment of variables in the original order into the
+	 * order given by @p perm (see Permute()).
+	 */
+	static SymbolicVarAsgn PermuteAsgn(
+		const SymbolicVarAsgn&   asgn,
+		const PermutationTable&  perm)
+	{
+		SymbolicVarAsgn result(std::max(asgn.length(), perm.size()));
+		for (size_t i = 0; i < asgn.length(); ++i)
+		{
+			result.SetIthVariableValue((i < perm.size())? perm[i] : i,
+				asgn.GetIthVariableValue(i));
+		}
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  Composes two permutations of variables
+	 *
+	 * @returns  The permutation that applies @p first and then @p second
+	 */
+	static PermutationTablePtr ComposePermutations(
+		const PermutationTable&  first,
+		const PermutationTable&  second)
+	{
+		PermutationTablePtr result(
+			new PermutationTable(std::max(first.size(), second.size())));
+
+		for (VarType var = 0; var < result->size(); ++var)
+		{
+			VarType tmp = (var < first.size())? first[var] : var;
+			(*result)[var] = (tmp < second.size())? second[tmp] : tmp;
+		}
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  The number of nodes of a set of MTBDDs
+	 *
+	 * Nodes shared among the MTBDDs are counted once.
+	 */
+	static size_t CountNodes(
+		const std::vector<const OndriksMTBDD*>&     mtbdds)
+	{
+		NodePtrSet nodes;
+		for (const OndriksMTBDD* bdd : mtbdds)
+		{
+			assert(bdd != nullptr);
+
+			collectNodes(bdd->getRoot(), nodes);
+		}
+
+		return nodes.size();
+	}
+
+
+	/**
+	 * @brief  Reorder variables by sifting
+	 *
+	 * Looks for a variable ordering that reduces the number of nodes of
+	 * @p mtbdds using Rudell's sifting: every variable (starting with the ones
+	 * labelling most nodes) is moved through the ordering by swaps with its
+	 * neighbours and left at the position where the MTBDDs were smallest. The
+	 * MTBDDs are replaced by their reordered versions.
+	 *
+	 * @note  The reordered MTBDDs have to be accessed using assignments
+	 *        translated by PermuteAsgn() with the resulting permutation, and
+	 *        may only be combined with MTBDDs in the same order.
+	 *
+	 * @param[in,out]  mtbdds  The MTBDDs to be reordered
+	 *
+	 * @returns  The numbers of nodes before and after, and the permutation
+	 */
+	static ReorderingResult Sift(
+		const std::vector<OndriksMTBDD*>&     mtbdds)
+	{
+		std::vector<const OndriksMTBDD*> constMtbdds(mtbdds.begin(), mtbdds.end());
+
+		NodePtrSet nodes;
+		for (const OndriksMTBDD* bdd : constMtbdds)
+		{
+			collectNodes(bdd->getRoot(), nodes);
+		}
+
+		std::vector<size_t> varNodes;
+		for (const NodePtrType& node : nodes)
+		{	// count nodes labelled by the variables
+			if (IsInternal(node))
+			{
+				VarType var = GetVarFromInternal(node);
+				if (var >= varNodes.size())
+				{
+					varNodes.resize(var + 1, 0);
+				}
+
+				++varNodes[var];
+			}
+		}
+
+		ReorderingResult result = {nodes.size(), nodes.size(),
+			PermutationTablePtr(new PermutationTable(varNodes.size()))};
+		nodes.clear();
+
+		// the position of every variable, and the variable at every position
+		PermutationTable& position = *result.permutation;
+		PermutationTable varAt(varNodes.size());
+		for (VarType var = 0; var < varNodes.size(); ++var)
+		{
+			position[var] = var;
+			varAt[var] = var;
+		}
+
+		std::vector<VarType> order(varAt);
+		std::stable_sort(order.begin(), order.end(),
+			[&varNodes](VarType lhs, VarType rhs)
+			{
+				return varNodes[lhs] > varNodes[rhs];
+			});
+
+		size_t current = result.nodesBefore;
+		auto swapUp = [&](VarType pos)
+			{	// swap the variables at positions pos and pos + 1
+				current = swapAdjacentVariables(mtbdds, pos);
+				std::swap(varAt[pos], varAt[pos + 1]);
+				position[varAt[pos]] = pos;
+				position[varAt[pos + 1]] = pos + 1;
+			};
+
+		for (VarType var : order)
+		{
+			if (varNodes[var] == 0)
+			{	// the variable does not occur in the MTBDDs
+				continue;
+			}
+
+			const VarType start = position[var];
+			size_t best = current;
+			VarType bestPos = start;
+
+			while ((position[var] > 0) &&
+				(100 * current <= SIFTING_MAX_GROWTH * best))
+			{	// move the variable down
+				swapUp(position[var] - 1);
+				if (current < best)
+				{
+					best = current;
+					bestPos = position[var];
+				}
+			}
+
+			while ((position[var] + 1 < varAt.size()) &&
+				((position[var] < start) ||
+				(100 * current <= SIFTING_MAX_GROWTH * best)))
+			{	// move the variable up
+				swapUp(position[var]);
+				if (current < best)
+				{
+					best = current;
+					bestPos = position[var];
+				}
+			}
+
+			while (position[var] > bestPos)
+			{	// return to the best position
+				swapUp(position[var] - 1);
+			}
+
+			while (position[var] < bestPos)
+			{
+				swapUp(position[var]);
+			}
+
+			assert(current == best);
+		}
+
+		result.nodesAfter = current;
+		return result;
+	}
+
+
+	/**
+	 * @brief  Reclaims unreferenced nodes
+	 *
+	 * Reclaims all nodes of MTBDDs with the data type of @p this in the current
+	 * thread that are not referenced by any MTBDD. This is done automatically
+	 * whenever enough MTBDDs have been released (see
+	 * SetGarbageCollectionThreshold()).
+	 */
+	static void CollectGarbage()
+	{
+		assert(!GarbageCollectionLock::IsLocked());
+
+		collectGarbage();
+	}
+
+	/**
+	 * @brief  Sets when garbage is collected
+	 *
+	 * Garbage is collected once @p threshold nodes have lost their last
+	 * reference. A low threshold saves memory, a high one lets more dead nodes
+	 * be reused by subsequent operations.
+	 *
+	 * @param[in]  threshold  The number of dead nodes
+	 */
+	static void SetGarbageCollectionThreshold(size_t threshold)
+	{
+		gcThreshold_ = threshold;
+	}
+
+	/**
+	 * @brief  The number of nodes
+	 *
+	 * Returns the number of nodes (both leaves and internal nodes) of MTBDDs
+	 * with the data type of @p this that exist in the current thread,
+	 * including unreferenced nodes that have not been collected yet.
+	 *
+	 * @returns  The number of nodes
+	 */
+	static size_t GetNodeCount()
+	{
+		return leafTable_.Size() + internalTable_.Size();
+	}
+
 	~OndriksMTBDD()
 	{
 		deleteMTBDD();
@@ -796,11 +1817,18 @@ public:   // public methods
 };
 
 template <typename Data>
-typename VATA::MTBDDPkg::OndriksMTBDD<Data>::LeafCacheType
-	VATA::MTBDDPkg::OndriksMTBDD<Data>::leafCache_;
+thread_local VATA::MTBDDPkg::UniqueTable
+	VATA::MTBDDPkg::OndriksMTBDD<Data>::leafTable_;
+
+template <typename Data>
+thread_local VATA::MTBDDPkg::UniqueTable
+	VATA::MTBDDPkg::OndriksMTBDD<Data>::internalTable_;
+
+template <typename Data>
+thread_local size_t VATA::MTBDDPkg::OndriksMTBDD<Data>::deadCount_ = 0;
 
 template <typename Data>
-typename VATA::MTBDDPkg::OndriksMTBDD<Data>::InternalCacheType
-	VATA::MTBDDPkg::OndriksMTBDD<Data>::internalCache_;
+thread_local size_t VATA::MTBDDPkg::OndriksMTBDD<Data>::gcThreshold_ =
+	VATA::MTBDDPkg::OndriksMTBDD<Data>::DEFAULT_GC_THRESHOLD;
 
 #endif
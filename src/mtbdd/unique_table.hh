@@ -0,0 +1,244 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Open-addressing unique table of MTBDD nodes
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_MTBDD_UNIQUE_TABLE_HH_
+#define _VATA_MTBDD_UNIQUE_TABLE_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+
+// Standard library headers
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace VATA
+{
+	namespace MTBDDPkg
+	{
+		class UniqueTable;
+	}
+}
+
+
+/**
+ * @brief  Unique table of MTBDD nodes
+ *
+ * The table is a hash set of 32-bit node indices (see NodeArena) with open
+ * addressing and linear probing. Every slot also stores the hash of its node,
+ * so that most mismatches are resolved without touching the node, and the
+ * table can be resized without rehashing the nodes. Nodes are removed using
+ * backward shifting, so there are no tombstones.
+ *
+ * The table does not know the nodes; the caller provides the hash of the key
+ * and a predicate that compares a node (given by its index) with the key.
+ */
+class VATA::MTBDDPkg::UniqueTable
+{
+public:   // public data types
+
+	typedef uint32_t IndexType;
+
+	/**
+	 * @brief  The value returned by Find() when the key is not present
+	 */
+	static const IndexType NOT_FOUND = std::numeric_limits<IndexType>::max();
+
+private:  // private data types
+
+	struct Slot
+	{
+		IndexType index;
+		uint32_t hash;
+	};
+
+private:  // private constants
+
+	static const size_t INITIAL_CAPACITY = 1024;
+
+private:  // private data members
+
+	std::vector<Slot> slots_;
+
+	size_t mask_;
+
+	size_t size_;
+
+private:  // private methods
+
+	UniqueTable(const UniqueTable&);
+	UniqueTable& operator=(const UniqueTable&);
+
+	// the final mix of MurmurHash3, so that poor low bits (such as the ones of
+	// aligned addresses) do not cause collisions
+	static uint32_t mix(size_t hash)
+	{
+		uint64_t h = hash;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+
+		return static_cast<uint32_t>(h);
+	}
+
+	void grow()
+	{
+		std::vector<Slot> old(2 * slots_.size(), Slot{NOT_FOUND, 0});
+		old.swap(slots_);
+		mask_ = slots_.size() - 1;
+
+		for (const Slot& slot : old)
+		{
+			if (NOT_FOUND != slot.index)
+			{
+				size_t i = slot.hash & mask_;
+				while (NOT_FOUND != slots_[i].index)
+				{
+					i = (i + 1) & mask_;
+				}
+
+				slots_[i] = slot;
+			}
+		}
+	}
+
+public:   // public methods
+
+	UniqueTable() :
+		slots_(INITIAL_CAPACITY, Slot{NOT_FOUND, 0}),
+		mask_(INITIAL_CAPACITY - 1),
+		size_(0)
+	{ }
+
+	/**
+	 * @brief  Finds a node
+	 *
+	 * @param[in]  hash   The hash of the key
+	 * @param[in]  match  Predicate telling whether the node with given index
+	 *                    has the key
+	 *
+	 * @returns  The index of the node, or @p NOT_FOUND
+	 */
+	template <class Match>
+	IndexType Find(size_t hash, Match match) const
+	{
+		uint32_t h = mix(hash);
+
+		for (size_t i = h & mask_; NOT_FOUND != slots_[i].index; i = (i + 1) & mask_)
+		{
+			if ((slots_[i].hash == h) && match(slots_[i].index))
+			{
+				return slots_[i].index;
+			}
+		}
+
+		return NOT_FOUND;
+	}
+
+	/**
+	 * @brief  Inserts a node whose key is not in the table
+	 */
+	void Insert(size_t hash, IndexType index)
+	{
+		assert(NOT_FOUND != index);
+
+		if (4 * (size_ + 1) > 3 * slots_.size())
+		{	// keep the load factor under 3/4
+			this->grow();
+		}
+
+		uint32_t h = mix(hash);
+
+		size_t i = h & mask_;
+		while (NOT_FOUND != slots_[i].index)
+		{
+			assert(slots_[i].index != index);
+			i = (i + 1) & mask_;
+		}
+
+		slots_[i] = Slot{index, h};
+		++size_;
+	}
+
+	/**
+	 * @brief  Removes a node
+	 *
+	 * @param[in]  hash   The hash of the key of the node
+	 * @param[in]  index  The index of the node
+	 *
+	 * @returns  @p true if the node was in the table
+	 */
+	bool Erase(size_t hash, IndexType index)
+	{
+		uint32_t h = mix(hash);
+
+		size_t i = h & mask_;
+		while (slots_[i].index != index)
+		{
+			if (NOT_FOUND == slots_[i].index)
+			{
+				return false;
+			}
+
+			i = (i + 1) & mask_;
+		}
+
+		// shift back the following slots that would not be reachable otherwise
+		size_t j = i;
+		while (true)
+		{
+			j = (j + 1) & mask_;
+			if (NOT_FOUND == slots_[j].index)
+			{
+				break;
+			}
+
+			size_t home = slots_[j].hash & mask_;
+			if (((j - home) & mask_) >= ((j - i) & mask_))
+			{	// the slot j may be moved to i
+				slots_[i] = slots_[j];
+				i = j;
+			}
+		}
+
+		slots_[i] = Slot{NOT_FOUND, 0};
+		--size_;
+
+		return true;
+	}
+
+	/**
+	 * @brief  Calls @p func for the index of every node in the table
+	 *
+	 * The table must not be modified by @p func.
+	 */
+	template <class Function>
+	void ForEach(Function func) const
+	{
+		for (const Slot& slot : slots_)
+		{
+			if (NOT_FOUND != slot.index)
+			{
+				func(slot.index);
+			}
+		}
+	}
+
+	size_t Size() const
+	{
+		return size_;
+	}
+};
+
+#endif
@@ -19,11 +19,11 @@ using VATA::SymbolicVarAsgn;
 SymbolicVarAsgn::SymbolicVarAsgn(
 	const std::string&                      value) :
 	variablesCount_(value.length()),
-	vars_(numberOfChars(value.length()))
+	vars_(numberOfWords(value.length()))
 {
 	for (size_t i = 0; i < value.length(); ++i)
 	{	// load the string into the array of variables
-		char val = 0;
+		WordType val = 0;
 
 		switch (value[i])
 		{
@@ -33,46 +33,8 @@ SymbolicVarAsgn::SymbolicVarAsgn(
 			default: throw std::runtime_error("Invalid input value!");
 		}
 
-		// prepare the mask
-		char mask = (DefaultMask << getIndexInsideChar(i)) ^ static_cast<char>(-1);
-
-		// mask out bits at given position by the mask
-		vars_[getIndexOfChar(i)] &= mask;
-
-		// prepare new value of given bits
-		val <<= getIndexInsideChar(i);
-
-		// insert the value of given bits
-		vars_[getIndexOfChar(i)] |= val;
-	}
-}
-
-
-void SymbolicVarAsgn::getAllSymbols(
-	SymbolicVarAsgn&                    var,
-	std::vector<SymbolicVarAsgn>&       vec,
-	size_t                              pos)
-{
-	if (pos == var.length())
-	{
-		vec.push_back(var);
-	}
-	else
-	{
-		if (var.GetIthVariableValue(pos) == DONT_CARE)
-		{	// in case we fork
-			var.SetIthVariableValue(pos, ZERO);
-			getAllSymbols(var, vec, pos + 1);
-			var.SetIthVariableValue(pos, ONE);
-			getAllSymbols(var, vec, pos + 1);
-
-			// return to the original value
-			var.SetIthVariableValue(pos, DONT_CARE);
-		}
-		else
-		{
-			getAllSymbols(var, vec, pos + 1);
-		}
+		// the bits are zero, so the value can be inserted directly
+		vars_[getIndexOfWord(i)] |= val << getIndexInsideWord(i);
 	}
 }
 
@@ -84,11 +46,14 @@ void SymbolicVarAsgn::AddVariablesUpTo(size_t maxVariableIndex)
 	{
 		size_t oldVariablesCount = variablesCount_;
 		variablesCount_ = newVariablesCount;
-		vars_.resize(numberOfChars(newVariablesCount));
+		vars_.resize(numberOfWords(newVariablesCount));
 
-		for (size_t i = oldVariablesCount; i < newVariablesCount; ++i)
-		{
-			SetIthVariableValue(i, DONT_CARE);
+		for (size_t i = getIndexOfWord(oldVariablesCount); i < vars_.size(); ++i)
+		{	// the bits of the new variables are still zero
+			WordType oldBits = (i == getIndexOfWord(oldVariablesCount))?
+				((WordType(1) << getIndexInsideWord(oldVariablesCount)) - 1) : 0;
+
+			vars_[i] |= getUsedBits(i) & ~oldBits;
 		}
 	}
 }
@@ -155,9 +120,16 @@ std::vector<SymbolicVarAsgn> SymbolicVarAsgn::GetVectorOfConcreteSymbols() const
 {
 	std::vector<SymbolicVarAsgn> result;
 
-	SymbolicVarAsgn newVar = *this;
+	size_t dontCares = GetDontCareCount();
+	if (dontCares < VariablesInWord)
+	{
+		result.reserve(static_cast<size_t>(1) << dontCares);
+	}
 
-	getAllSymbols(newVar, result, 0);
+	for (const SymbolicVarAsgn& symbol : GetConcreteSymbols())
+	{
+		result.push_back(symbol);
+	}
 
 	return result;
 }
@@ -163,31 +163,12 @@ SymbolicFiniteAutBDD::AssignmentList SymbolicFiniteAutBDD::GetAllAssignments(
 )
 const
 {
-  assert(this->mtbdd_ != nullptr);
-
-  AssignmentList list = this->mtbdd_->GetAllAssignments();
-
-  for (AssignmentList::iterator it = list.begin(); it != list.end(); it++)
-  { // completes the assignment according to desired length
-    (*it).append(SymbolicVarAsgn(this->vars_ - (*it).length()));
-  }
-
-  if (concretize)
-  { // we want concrete assignments
-    AssignmentList tempList;
+  AssignmentList list;
 
-    for (auto elem : list)
-    { // for all assignments create a vector of concrete assignments
-      AssignmentList concreteList = elem.GetVectorOfConcreteSymbols();
-
-      for (auto concrete : concreteList)
-      { // for all concrete assignments push them back to a temporary vector
-        tempList.push_back(concrete);
-      }
-    }
-
-    list = tempList;
-  }
+  this->ForEachAssignment(
+    [&list](const SymbolicVarAsgn & asgn){list.push_back(asgn);},
+    concretize
+  );
 
   return list;
 }
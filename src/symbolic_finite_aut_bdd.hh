@@ -240,6 +240,41 @@ public: // methods
     const bool & concretize = false
   ) const;
 
+  /**
+   * @brief  Visits all assignments in a BDD
+   *
+   * Unlike GetAllAssignments(), the assignments are not collected but passed
+   * to @p visitor one by one as they are found.
+   *
+   * @param[in]  visitor     Functor called on every assignment
+   * @param[in]  concretize  Concretize all assignments
+   */
+  template <class Visitor>
+  void ForEachAssignment(
+    Visitor        visitor,
+    const bool &   concretize = false
+  ) const
+  {
+    assert(this->mtbdd_ != nullptr);
+
+    this->mtbdd_->ForEachAssignment(
+      [&visitor, &concretize](const SymbolicVarAsgn & asgn){
+        if (concretize)
+        { // we want concrete assignments
+          for (const SymbolicVarAsgn & concrete : asgn.GetConcreteSymbols())
+          {
+            visitor(concrete);
+          }
+        }
+        else
+        {
+          visitor(asgn);
+        }
+      },
+      this->vars_
+    );
+  }
+
   /**
    * @brief  Conversion from SymbolicVarAsgn to size_t
    *
@@ -413,6 +448,35 @@ public: // methods
     );
   }
 
+  /**
+   * @brief  Relational product
+   *
+   * Computes the conjunction with @p rhs and existentially quantifies
+   * the variables satisfying @p pred in a single pass. It is equivalent to
+   * projecting the conjunction with OrApplyFunctor, but the conjunction is
+   * never built as a whole.
+   *
+   * @param[in]  rhs   BDD to conjoin with
+   * @param[in]  vars  Result number of variables of assignments
+   * @param[in]  pred  The predicate that denotes the variables to quantify out
+   *
+   * @return  Quantified conjunction of BDDs
+   */
+  template <class VarPredicate>
+  SymbolicFiniteAutBDD AndExists(
+    const SymbolicFiniteAutBDD & rhs,
+    const size_t &               vars,
+    VarPredicate                 pred
+  ) const
+  {
+    VATA::MTBDDPkg::AndExistsFunctor<VarPredicate> andExistsFunc(pred);
+
+    return SymbolicFiniteAutBDD(
+      andExistsFunc(GetBDD(), rhs.GetBDD()),
+      vars
+    );
+  }
+
 	/**
 	 * @brief  Rename variables
 	 *
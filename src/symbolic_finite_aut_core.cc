@@ -215,14 +215,11 @@ DumpToAutDescSymbolic() const
   assert(this->initialStates_ != nullptr);
   assert(this->finalStates_   != nullptr);
 
-  AssignmentList transitionList = transitions_->GetAllAssignments();
-  AssignmentList initialStateList = initialStates_->GetAllAssignments();
-  AssignmentList finalStatesList = finalStates_->GetAllAssignments();
-
   AutDescription desc;
 
-  for (auto transition : transitionList)
-  { // transitions
+  transitions_->ForEachAssignment([this, &desc](
+    const SymbolicVarAsgn & transition
+  ){ // transitions
     std::string lstate;
     std::string symbol;
     std::string rstate;
@@ -247,10 +244,11 @@ DumpToAutDescSymbolic() const
         rstate
       )
     );
-  }
+  });
 
-  for (auto initialState : initialStateList)
-  { // initial states
+  initialStates_->ForEachAssignment([this, &desc](
+    const SymbolicVarAsgn & initialState
+  ){ // initial states
     desc.transitions.insert(
       VATA::Util::Triple<
         std::vector<std::string>,
@@ -262,12 +260,13 @@ DumpToAutDescSymbolic() const
         initialState.ToString()
       )
     );
-  }
+  });
 
-  for (auto finalState : finalStatesList)
-  { // final states
+  finalStates_->ForEachAssignment([&desc](
+    const SymbolicVarAsgn & finalState
+  ){ // final states
     desc.finalStates.insert(finalState.ToString());
-  }
+  });
 
   return desc;
 }
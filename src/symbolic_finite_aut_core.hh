@@ -443,13 +443,10 @@ public: // public methods
     assert(initialStates_ != nullptr);
     assert(finalStates_   != nullptr);
 
-    AssignmentList transitionList   = transitions_->GetAllAssignments(true);
-    AssignmentList initialStateList = initialStates_->GetAllAssignments(true);
-    AssignmentList finalStatesList  = finalStates_->GetAllAssignments(true);
-
     AutDescription desc;
 
-    for (auto transition : transitionList)
+    transitions_->ForEachAssignment([this, &desc, &stateBackTransl,
+      &symbolBackTransl](const SymbolicVarAsgn & transition)
     { // transitions
       size_t lstate;
       size_t symbol;
@@ -475,9 +472,10 @@ public: // public methods
           stateBackTransl(rstate)
         )
       );
-    }
+    }, true);
 
-    for (auto initialState : initialStateList)
+    initialStates_->ForEachAssignment([&desc, &stateBackTransl](
+      const SymbolicVarAsgn & initialState)
     { // initial states
       desc.transitions.insert(
         VATA::Util::Triple<
@@ -490,14 +488,15 @@ public: // public methods
           stateBackTransl(SymbolicFiniteAutBDD::FromSymbolic(initialState))
         )
       );
-    }
+    }, true);
 
-    for (auto finalState : finalStatesList)
+    finalStates_->ForEachAssignment([&desc, &stateBackTransl](
+      const SymbolicVarAsgn & finalState)
     { // final states
       desc.finalStates.insert(
         stateBackTransl(SymbolicFiniteAutBDD::FromSymbolic(finalState))
       );
-    }
+    }, true);
 
     return desc;
   }
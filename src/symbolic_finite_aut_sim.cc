@@ -92,7 +92,6 @@ IterateSimulation(
 )
 {
   SymbolicFiniteAutBDD result, lhs, rhs;
-  SymbolicFiniteAutBDD::OrApplyFunctor unionFunc;
   SymbolicFiniteAutBDD::AndApplyFunctor isectFunc;
   SymbolicFiniteAutBDD::ImplicApplyFunctor implicFunc;
 
@@ -116,22 +115,16 @@ IterateSimulation(
   );
 
   // "q2" is simulated by "q3" AND "q4" transitions to "q3" using "a"
-  result = SymbolicFiniteAutBDD(
-    isectFunc(lhs.GetBDD(), rhs.GetBDD()),
-    aut.stateVars_ + aut.stateVars_ + aut.symbolVars_ + aut.stateVars_ +
-    aut.stateVars_
-  );
-
-  // there exists such "q3" that applies to previous statement
-  result = result.Project(
+  // and there exists such "q3" that applies to this statement
+  result = lhs.AndExists(
+    rhs,
     aut.stateVars_ + aut.stateVars_ + aut.symbolVars_ + aut.stateVars_,
     [aut](const size_t var){
       if (var < (aut.stateVars_ + aut.stateVars_ + aut.symbolVars_ +
                  aut.stateVars_))
         return false;
       else return true;
-    },
-    unionFunc
+    }
   );
 
   // reindex Q1 so it can overlap
@@ -257,33 +250,30 @@ std::string SymbolicFiniteAutCore::DumpSimulation(
       2 * stateVars
     );
 
-    AssignmentList list = simLimited.GetAllAssignments(true);
     StateBackTranslStrict StateBackTranslFunc(stateDict->GetReverseMap());
 
     auto translFunc = [&StateBackTranslFunc](const std::string str){
       return StateBackTranslFunc(SymbolicFiniteAutBDD::FromSymbolic(str));
     };
 
-    for (auto elem : list)
+    simLimited.ForEachAssignment([&](const SymbolicVarAsgn & elem)
     {
       std::string str = elem.ToString();
       result += translFunc(str.substr(0 , stateVars)) + " <= ";
       result += translFunc(str.substr(stateVars, stateVars)) + "\n";
-    }
+    }, true);
 
     return result;
   }
 
   else
   { // symbolic serialization
-    AssignmentList list = sim.GetAllAssignments();
-
-    for (auto elem : list)
+    sim.ForEachAssignment([&](const SymbolicVarAsgn & elem)
     {
       std::string str = elem.ToString();
       result += str.substr(0 , stateVars) + " <= ";
       result += str.substr(stateVars, stateVars) + "\n";
-    }
+    });
 
     return result;
   }
@@ -301,9 +291,7 @@ MatrixSimulation(
   StateBinaryRelation result(pow(2, stateVars));
 
   // surely not effective for symbolically loaded automata
-  AssignmentList list = sim.GetAllAssignments(true);
-
-  for (auto elem : list)
+  sim.ForEachAssignment([&](const SymbolicVarAsgn & elem)
   {
     std::string str = elem.ToString();
 
@@ -312,7 +300,7 @@ MatrixSimulation(
       SymbolicFiniteAutBDD::FromSymbolic(str.substr(stateVars, stateVars)),
       true
     );
-  }
+  }, true);
 
   return result;
 }
\ No newline at end of file
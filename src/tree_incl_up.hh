@@ -39,6 +39,8 @@ bool VATA::CheckUpwardTreeInclusion(const Aut& smaller, const Aut& bigger,
 	typedef typename InclFctor::StateSet StateSet;
 	typedef typename InclFctor::StateTuple StateTuple;
 	typedef typename InclFctor::StateTupleSet StateTupleSet;
+	typedef typename Aut::TransMTBDD TransMTBDD;
+	typedef typename Aut::TupleId TupleId;
 
 	typedef typename std::vector<std::set<StateType>> StateSetTuple;
 
@@ -52,7 +54,7 @@ bool VATA::CheckUpwardTreeInclusion(const Aut& smaller, const Aut& bigger,
 		typedef std::vector<typename InternalContainerType::const_iterator>
 			ChoiceFunctionType;
 		typedef StateSetTuple DomainType;
-		typedef std::vector<StateType> ResultType;
+		typedef StateTuple ResultType;
 
 
 	private:  // data members
@@ -136,14 +138,9 @@ bool VATA::CheckUpwardTreeInclusion(const Aut& smaller, const Aut& bigger,
 	StateSet procSet;
 	while (workset.get(procState, procSet))
 	{
-		for (auto tupleBddPair : smaller.GetTransTable())
-		{	// for each tuple in the smaller aut
-			const StateTuple& tuple = tupleBddPair.first;
-			if (std::find(tuple.begin(), tuple.end(), procState) == tuple.end())
-			{	// if the tuple does not contain the processed state
-				continue;
-			}
-
+		smaller.ForeachTupleWithChildDo(procState, [&](const StateTuple& tuple,
+			const TransMTBDD& /* bdd */, const TupleId& /* id */)
+		{	// for each tuple with the processed state in the smaller aut
 			bool allElementsInAntichain = true;
 			for (size_t index = 0; index < tuple.size(); ++index)
 			{
@@ -161,7 +158,7 @@ bool VATA::CheckUpwardTreeInclusion(const Aut& smaller, const Aut& bigger,
 
 			if (!allElementsInAntichain)
 			{	// if the tuple is not reachable yet
-				continue;
+				return;
 			}
 
 			// create a tuple of sets of states
@@ -210,7 +207,7 @@ bool VATA::CheckUpwardTreeInclusion(const Aut& smaller, const Aut& bigger,
 
 			Aut::ForeachUpSymbolFromTupleAndTupleSetDo(smaller, bigger, tuple,
 				tupleSet, upFctor);
-		}
+		});
 
 		if (!upFctor.InclusionHolds())
 		{	// in case a counterexample was found
@@ -0,0 +1,192 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Arena-backed cache template header file.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_ARENA_CACHE_HH_
+#define _VATA_ARENA_CACHE_HH_
+
+
+// standard library headers
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	template <class T> class ArenaCache;
+}}
+
+
+/**
+ * @brief  An arena-backed cache for objects
+ *
+ * This class interns objects of the type @p T: equal objects are mapped to
+ * the same instance, which is identified by a dense 32-bit ID. The objects are
+ * stored in an arena with stable addresses and are never released one by one;
+ * instead, the whole arena is released in bulk when the cache is cleared or
+ * destroyed.
+ *
+ * The interface is compatible with Util::Cache: lookup() returns a shared
+ * pointer to the interned object. All the pointers share the control block of
+ * the arena (they are created using the aliasing constructor), so there is no
+ * per-object control block and no bookkeeping on release. Pointers handed out
+ * before clear() keep the old arena alive, but they are no longer interned,
+ * i.e., the same object may afterwards be given a different address.
+ */
+template <
+	class T>
+class VATA::Util::ArenaCache
+{
+public:   // data types
+
+	using TPtr             = typename std::shared_ptr<T>;
+	using IdType           = uint32_t;
+
+private:  // data types
+
+	using Arena            = std::deque<T>;
+	using ArenaPtr         = std::shared_ptr<Arena>;
+
+	struct DerefHash
+	{
+		size_t operator()(const T* x) const
+		{
+			return boost::hash<T>()(*x);
+		}
+	};
+
+	struct DerefEqual
+	{
+		bool operator()(const T* lhs, const T* rhs) const
+		{
+			return *lhs == *rhs;
+		}
+	};
+
+	using TToIdMap         = std::unordered_map<const T*, IdType, DerefHash, DerefEqual>;
+
+private:  // data members
+
+	ArenaPtr arena_;
+	TToIdMap store_;
+
+private:  // methods
+
+	ArenaCache(const ArenaCache&);
+	ArenaCache& operator=(const ArenaCache&);
+
+public:   // methods
+
+	ArenaCache() :
+		arena_(new Arena()),
+		store_()
+	{ }
+
+	TPtr find(
+		const T&                  x)
+	{
+		auto i = store_.find(&x);
+
+		return (i == store_.end())?(TPtr(nullptr)):(this->get(i->second));
+	}
+
+	TPtr lookup(
+		const T&                  x)
+	{
+		return this->get(this->lookupId(x));
+	}
+
+	/**
+	 * @brief  Interns an object and returns its ID
+	 *
+	 * @param[in]  x  The object
+	 *
+	 * @returns  The ID of the interned copy of @p x
+	 */
+	IdType lookupId(
+		const T&                  x)
+	{
+		auto i = store_.find(&x);
+		if (i != store_.end())
+		{
+			return i->second;
+		}
+
+		IdType id = static_cast<IdType>(arena_->size());
+		assert(static_cast<size_t>(id) == arena_->size());
+
+		arena_->push_back(x);
+		store_.insert(std::make_pair(&arena_->back(), id));
+
+		return id;
+	}
+
+	/**
+	 * @brief  Retrieves the ID of an interned object
+	 *
+	 * @param[in]  x  The object (it needs to be in the cache)
+	 *
+	 * @returns  The ID of @p x
+	 */
+	IdType getId(
+		const T&                  x) const
+	{
+		auto i = store_.find(&x);
+		assert(i != store_.end());
+
+		return i->second;
+	}
+
+	TPtr get(
+		IdType                    id)
+	{
+		assert(static_cast<size_t>(id) < arena_->size());
+
+		return TPtr(arena_, &(*arena_)[id]);
+	}
+
+	const T& operator[](
+		IdType                    id) const
+	{
+		assert(static_cast<size_t>(id) < arena_->size());
+
+		return (*arena_)[id];
+	}
+
+	size_t size() const
+	{
+		return arena_->size();
+	}
+
+	bool empty() const
+	{
+		return arena_->empty();
+	}
+
+	/**
+	 * @brief  Releases all objects in bulk
+	 *
+	 * The memory of the arena is returned once no pointer obtained by lookup()
+	 * or get() refers to it.
+	 */
+	void clear()
+	{
+		store_.clear();
+		arena_ = ArenaPtr(new Arena());
+	}
+};
+
+
+#endif
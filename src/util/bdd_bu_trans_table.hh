@@ -13,9 +13,12 @@
 
 // VATA headers
 #include <vata/vata.hh>
+#include <vata/util/small_vector.hh>
 
 // Standard library headers
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 
 namespace VATA
@@ -40,61 +43,213 @@ class VATA::Util::BDDBottomUpTransTable
 public:   // data types
 
 	typedef State StateType;
-	typedef std::vector<StateType> StateTuple;
+	typedef Util::SmallVector<StateType, 3> StateTuple;
 	typedef Leaf LeafType;
 	typedef VATA::MTBDDPkg::OndriksMTBDD<LeafType> MTBDD;
-	typedef std::unordered_map<StateTuple, MTBDD, boost::hash<StateTuple>>
-		TupleMap;
+
+	/**
+	 * @brief  Dense identifier of a tuple in the table
+	 */
+	typedef size_t TupleId;
+	typedef std::vector<TupleId> TupleIdList;
+
+	static const TupleId NO_TUPLE = static_cast<TupleId>(-1);
+
+private:  // data types
+
+	typedef std::unordered_map<StateTuple, TupleId, boost::hash<StateTuple>>
+		TupleIdMap;
+	typedef std::unordered_map<StateType, TupleIdList> ChildIndex;
 
 private:  // data members
 
 	MTBDD defaultMtbdd_;
 
-	TupleMap mtbddMap_;
+	/**
+	 * @brief  Interned tuples
+	 *
+	 * A tuple is hashed only when it is interned or looked up by its value;
+	 * everything else goes through its identifier.
+	 */
+	TupleIdMap tupleIds_;
+
+	/// @brief  Tuples indexed by their identifiers
+	std::vector<StateTuple> tuples_;
+
+	/// @brief  MTBDDs indexed by identifiers of their tuples
+	std::vector<MTBDD> mtbdds_;
+
+	/// @brief  Whether the tuple has an MTBDD (it has not been removed)
+	std::vector<bool> present_;
+
+	/// @brief  The number of present tuples
+	size_t size_;
+
+	/**
+	 * @brief  Tuples containing a state
+	 *
+	 * Every tuple is listed once for each distinct state it contains, in the
+	 * order of their identifiers.
+	 */
+	ChildIndex childIndex_;
+
+	/// @brief  Returned for states that are in no tuple
+	TupleIdList emptyIdList_;
 
 public:   // methods
 
 	BDDBottomUpTransTable() :
 		defaultMtbdd_(LeafType()),
-		mtbddMap_()
+		tupleIds_(),
+		tuples_(),
+		mtbdds_(),
+		present_(),
+		size_(0),
+		childIndex_(),
+		emptyIdList_()
 	{ }
 
+	/**
+	 * @brief  Gets the identifier of a tuple
+	 *
+	 * @returns  The identifier, or @p NO_TUPLE if the tuple was never set
+	 */
+	inline TupleId GetTupleId(const StateTuple& tuple) const
+	{
+		typename TupleIdMap::const_iterator itHt;
+		if ((itHt = tupleIds_.find(tuple)) == tupleIds_.end())
+		{
+			return NO_TUPLE;
+		}
+
+		return itHt->second;
+	}
+
 	inline const MTBDD& GetMtbdd(const StateTuple& tuple) const
 	{
-		typename TupleMap::const_iterator itHt;
-		if ((itHt = mtbddMap_.find(tuple)) == mtbddMap_.end())
+		TupleId id = this->GetTupleId(tuple);
+		if (NO_TUPLE == id)
 		{	// in case we are trying to access some nonsense
 			return defaultMtbdd_;
 		}
 
-		return itHt->second;
+		return mtbdds_[id];
+	}
+
+	inline const MTBDD& GetMtbddById(TupleId id) const
+	{
+		assert(id < mtbdds_.size());
+
+		return mtbdds_[id];
+	}
+
+	inline const StateTuple& GetTuple(TupleId id) const
+	{
+		assert(id < tuples_.size());
+
+		return tuples_[id];
+	}
+
+	/**
+	 * @brief  Checks whether the tuple of an identifier has an MTBDD
+	 */
+	inline bool IsPresent(TupleId id) const
+	{
+		assert(id < present_.size());
+
+		return present_[id];
+	}
+
+	/**
+	 * @brief  Gets the identifiers of tuples containing a state
+	 *
+	 * The list may contain identifiers of removed tuples.
+	 */
+	inline const TupleIdList& GetTuplesWithChild(const StateType& state) const
+	{
+		typename ChildIndex::const_iterator itIndex;
+		if ((itIndex = childIndex_.find(state)) == childIndex_.end())
+		{
+			return emptyIdList_;
+		}
+
+		return itIndex->second;
+	}
+
+	/**
+	 * @brief  The number of identifiers given so far
+	 *
+	 * Identifiers are dense, i.e., all identifiers are lower than this number.
+	 */
+	inline size_t GetTupleIdCount() const
+	{
+		return tuples_.size();
 	}
 
 	inline void SetMtbdd(const StateTuple& tuple, const MTBDD& bdd)
 	{
-		auto itBoolPair = mtbddMap_.insert(std::make_pair(tuple, bdd));
-		if (!itBoolPair.second)
-		{	// in case there already is something
-			(itBoolPair.first)->second = bdd;
+		TupleId id = this->internTuple(tuple);
+		mtbdds_[id] = bdd;
+		if (!present_[id])
+		{
+			present_[id] = true;
+			++size_;
 		}
 	}
 
+	/**
+	 * @brief  Removes the MTBDD of a tuple
+	 *
+	 * The tuple keeps its identifier, which is reused if the tuple is set
+	 * again.
+	 */
 	inline void RemoveMtbdd(const StateTuple& tuple)
 	{
-		if (mtbddMap_.erase(tuple) != 1)
+		TupleId id = this->GetTupleId(tuple);
+		if ((NO_TUPLE == id) || !present_[id])
 		{
 			assert(false);
+			return;
 		}
+
+		mtbdds_[id] = defaultMtbdd_;
+		present_[id] = false;
+		--size_;
 	}
 
-	inline const TupleMap& GetTupleMap() const
+	inline size_t size() const
 	{
-		return mtbddMap_;
+		return size_;
 	}
 
-	inline size_t size() const
+private:  // methods
+
+	TupleId internTuple(const StateTuple& tuple)
 	{
-		return mtbddMap_.size();
+		auto itBoolPair = tupleIds_.insert(std::make_pair(tuple, tuples_.size()));
+		if (!itBoolPair.second)
+		{	// in case the tuple is already known
+			return itBoolPair.first->second;
+		}
+
+		TupleId id = itBoolPair.first->second;
+		tuples_.push_back(tuple);
+		mtbdds_.push_back(defaultMtbdd_);
+		present_.push_back(false);
+
+		for (size_t i = 0; i < tuple.size(); ++i)
+		{
+			const StateType& state = tuple[i];
+			if (std::find(tuple.begin(), tuple.begin() + i, state) !=
+				tuple.begin() + i)
+			{	// the tuple is already listed for the state
+				continue;
+			}
+
+			childIndex_[state].push_back(id);
+		}
+
+		return id;
 	}
 };
 
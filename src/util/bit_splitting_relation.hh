@@ -0,0 +1,236 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Splitting relation stored as a bit matrix.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_BIT_SPLITTING_RELATION_HH_
+#define _VATA_BIT_SPLITTING_RELATION_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// VATA headers
+#include <vata/vata.hh>
+
+#include "../util/bit_vector.hh"
+
+namespace VATA
+{
+	namespace Util
+	{
+		class BitSplittingRelation;
+	}
+}
+
+/**
+ * @brief  Splitting relation stored as a bit matrix
+ *
+ * This is an alternative to SplittingRelation with the same interface. Rows
+ * are word-aligned bit vectors stored in a single array, so that removing a
+ * set of columns from a row (the most frequent operation of the simulation
+ * algorithm) is a bulk word operation (see BitVector). The matrix grows
+ * together with the number of blocks, its memory footprint is quadratic in
+ * the number of blocks regardless of the number of pairs in the relation.
+ */
+class VATA::Util::BitSplittingRelation {
+
+public:
+
+	typedef BitVector::Word Word;
+
+	/**
+	 * @brief  Distinct rows can be modified concurrently
+	 */
+	static const bool ConcurrentRows = true;
+
+private:
+
+	std::vector<Word> bits_;
+	std::vector<Word> tmp_;
+	size_t stride_;
+	size_t size_;
+	size_t maxSize_;
+
+	Word* rowData(size_t row) {
+
+		return this->bits_.data() + row*this->stride_;
+
+	}
+
+	const Word* rowData(size_t row) const {
+
+		return this->bits_.data() + row*this->stride_;
+
+	}
+
+	bool get(size_t row, size_t col) const {
+
+		return (this->rowData(row)[col / BitVector::WordBits] >> (col % BitVector::WordBits)) & 1;
+
+	}
+
+	void set(size_t row, size_t col, bool value) {
+
+		Word& w = this->rowData(row)[col / BitVector::WordBits];
+		Word mask = Word(1) << (col % BitVector::WordBits);
+
+		w = (value)?(w | mask):(w & ~mask);
+
+	}
+
+	// makes room for the given number of rows and columns
+	void reserve(size_t size) {
+
+		assert(size <= this->maxSize_);
+
+		if (size > this->stride_*BitVector::WordBits) {
+
+			size_t stride = std::max(this->stride_, size_t(1));
+
+			while (stride*BitVector::WordBits < size)
+				stride <<= 1;
+
+			stride = std::min(stride, BitVector::wordCount(this->maxSize_));
+
+			std::vector<Word> bits(this->size_*stride);
+
+			for (size_t i = 0; i < this->size_; ++i) {
+
+				std::memcpy(
+					bits.data() + i*stride, this->rowData(i), this->stride_*sizeof(Word)
+				);
+
+			}
+
+			this->bits_.swap(bits);
+			this->tmp_.resize(stride);
+			this->stride_ = stride;
+
+		}
+
+		if (this->bits_.size() < size*this->stride_)
+			this->bits_.resize(size*this->stride_);
+
+	}
+
+public:
+
+	BitSplittingRelation(size_t maxSize) :
+		bits_(), tmp_(), stride_(), size_(), maxSize_(maxSize) {}
+
+	template <class Index>
+	void init(const Index& index) {
+
+		this->reserve(index.size());
+
+		this->size_ = index.size();
+
+		for (size_t i = 0; i < index.size(); ++i) {
+
+			assert(index[i].size());
+
+			for (auto& j : index[i]) {
+
+				assert(j < index.size());
+
+				this->set(i, j, true);
+
+			}
+
+		}
+
+	}
+
+	size_t split(size_t index) {
+
+		assert(index < this->size_);
+
+		size_t newIndex = this->size_;
+
+		this->reserve(newIndex + 1);
+
+		// copy row
+		std::memcpy(
+			this->rowData(newIndex), this->rowData(index), this->stride_*sizeof(Word)
+		);
+
+		// copy column
+		for (size_t i = 0; i < newIndex; ++i)
+			this->set(i, newIndex, this->get(i, index));
+
+		// reflexivity
+		this->set(newIndex, newIndex, true);
+
+		++this->size_;
+
+		return newIndex;
+
+	}
+
+	/**
+	 * @brief  Calls @p f with every column related to the row @p index
+	 */
+	template <class F>
+	void forEach(size_t index, F f) const {
+
+		assert(index < this->size_);
+
+		BitVector::forEachSet(this->rowData(index), this->stride_, f);
+
+	}
+
+	/**
+	 * @brief  Removes the columns in @p mask from the row @p index
+	 *
+	 * The functor @p f is called with every removed column.
+	 */
+	template <class F>
+	void eraseMasked(size_t index, const BitVector& mask, F f) {
+
+		this->eraseMasked(index, mask, f, this->tmp_);
+
+	}
+
+	/**
+	 * @brief  Removes the columns in @p mask from the row @p index
+	 *
+	 * This variant uses the buffer @p scratch instead of the internal one, so
+	 * it can be called concurrently for distinct rows.
+	 */
+	template <class F>
+	void eraseMasked(size_t index, const BitVector& mask, F f, std::vector<Word>& scratch) {
+
+		assert(index < this->size_);
+
+		size_t n = std::min(this->stride_, mask.words());
+
+		if (scratch.size() < n)
+			scratch.resize(n);
+
+		Word* row = this->rowData(index);
+
+		if (!BitVector::andInto(scratch.data(), row, mask.data(), n))
+			return;
+
+		BitVector::andNot(row, mask.data(), n);
+
+		BitVector::forEachSet(scratch.data(), n, f);
+
+	}
+
+	const size_t& size() const {
+
+		return this->size_;
+
+	}
+
+};
+
+#endif
@@ -0,0 +1,201 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Word-aligned bit vector with bulk word operations.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_BIT_VECTOR_HH_
+#define _VATA_BIT_VECTOR_HH_
+
+// Standard library headers
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// VATA headers
+#include <vata/vata.hh>
+
+namespace VATA
+{
+	namespace Util
+	{
+		class BitVector;
+	}
+}
+
+/**
+ * @brief  A bit vector stored in 64-bit words
+ *
+ * Apart from the usual bit access, the class provides static bulk operations
+ * on arrays of words, which are used for whole-row operations of bit matrices.
+ * The bulk operations use AVX2 when the library is compiled with it enabled
+ * (e.g., using -mavx2 or -march=native), and plain word loops otherwise.
+ */
+class VATA::Util::BitVector {
+
+public:
+
+	typedef uint64_t Word;
+
+	static const size_t WordBits = 64;
+
+private:
+
+	std::vector<Word> words_;
+	size_t size_;
+
+public:
+
+	static size_t wordCount(size_t bits) {
+
+		return (bits + WordBits - 1) / WordBits;
+
+	}
+
+	/**
+	 * @brief  dst[i] &= ~src[i] for all i < n
+	 */
+	static void andNot(Word* dst, const Word* src, size_t n) {
+
+		size_t i = 0;
+
+#ifdef __AVX2__
+		for (; i + 4 <= n; i += 4) {
+
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_andnot_si256(s, d));
+
+		}
+#endif
+
+		for (; i < n; ++i)
+			dst[i] &= ~src[i];
+
+	}
+
+	/**
+	 * @brief  out[i] = lhs[i] & rhs[i] for all i < n
+	 *
+	 * @returns  @p true in case some word of @p out is nonzero
+	 */
+	static bool andInto(Word* out, const Word* lhs, const Word* rhs, size_t n) {
+
+		size_t i = 0;
+		Word any = 0;
+
+#ifdef __AVX2__
+		__m256i acc = _mm256_setzero_si256();
+
+		for (; i + 4 <= n; i += 4) {
+
+			__m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+			__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+			__m256i x = _mm256_and_si256(l, r);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+
+			acc = _mm256_or_si256(acc, x);
+
+		}
+
+		any = !_mm256_testz_si256(acc, acc);
+#endif
+
+		for (; i < n; ++i) {
+
+			out[i] = lhs[i] & rhs[i];
+			any |= out[i];
+
+		}
+
+		return any != 0;
+
+	}
+
+	/**
+	 * @brief  Calls @p f with the index of every set bit of @p words
+	 */
+	template <class F>
+	static void forEachSet(const Word* words, size_t n, F f) {
+
+		for (size_t i = 0; i < n; ++i) {
+
+			Word w = words[i];
+
+			while (w) {
+
+				f(i * WordBits + static_cast<size_t>(__builtin_ctzll(w)));
+
+				w &= w - 1;
+
+			}
+
+		}
+
+	}
+
+public:
+
+	explicit BitVector(size_t size = 0) : words_(wordCount(size)), size_(size) {}
+
+	void resize(size_t size) {
+
+		this->words_.resize(wordCount(size));
+		this->size_ = size;
+
+	}
+
+	size_t size() const { return this->size_; }
+
+	size_t words() const { return this->words_.size(); }
+
+	const Word* data() const { return this->words_.data(); }
+
+	Word* data() { return this->words_.data(); }
+
+	bool test(size_t i) const {
+
+		assert(i < this->size_);
+
+		return (this->words_[i / WordBits] >> (i % WordBits)) & 1;
+
+	}
+
+	bool operator[](size_t i) const { return this->test(i); }
+
+	void set(size_t i) {
+
+		assert(i < this->size_);
+
+		this->words_[i / WordBits] |= Word(1) << (i % WordBits);
+
+	}
+
+	void reset(size_t i) {
+
+		assert(i < this->size_);
+
+		this->words_[i / WordBits] &= ~(Word(1) << (i % WordBits));
+
+	}
+
+	template <class F>
+	void forEach(F f) const {
+
+		BitVector::forEachSet(this->words_.data(), this->words_.size(), f);
+
+	}
+
+};
+
+#endif
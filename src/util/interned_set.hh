@@ -0,0 +1,424 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Hash-consed ordered sets header file.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_INTERNED_SET_HH_
+#define _VATA_INTERNED_SET_HH_
+
+// VATA headers
+#include <vata/vata.hh>
+#include <vata/util/ord_vector.hh>
+
+#include "arena_cache.hh"
+
+// standard library headers
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <vector>
+
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	template <class Key> class InternedSet;
+}}
+
+
+/**
+ * @brief  A hash-consed immutable ordered set
+ *
+ * An object of this class is a 32-bit ID of an OrdVector interned in a set
+ * store shared by all objects of the class in the current thread. Equal sets
+ * are given the same ID, so that comparison and hashing of two sets (e.g. of
+ * two leaves of an MTBDD) take constant time. Union and intersection of two
+ * sets are memoised in fixed-size lossy tables of the store (a newer result
+ * simply overwrites an older one with the same hash, as in the computed table
+ * of the MTBDD package).
+ *
+ * The store is thread-local (as are the tables of the MTBDD package), so an
+ * object is only meaningful in the thread that created it. Sets passed to
+ * another thread (e.g. to a worker of a thread pool) need to be exported using
+ * Get() and interned again there. The interned sets are released when the
+ * thread terminates or when the store is reset using Reset().
+ *
+ * @tparam  Key  The type of elements of the set
+ */
+template <
+	class Key>
+class VATA::Util::InternedSet
+{
+public:   // data types
+
+	using SetType          = OrdVector<Key>;
+	using IdType           = uint32_t;
+	using const_iterator   = typename SetType::const_iterator;
+	using iterator         = const_iterator;
+
+private:  // data types
+
+	/**
+	 * @brief  Entry of an operation cache
+	 *
+	 * The operands are ordered and distinct, so an entry with both operands
+	 * equal to EMPTY_ID is unused.
+	 */
+	struct OpEntry
+	{
+		IdType lhs;
+		IdType rhs;
+		IdType result;
+	};
+
+	/**
+	 * @brief  Lossy cache of results of a binary operation
+	 */
+	GCC_DIAG_OFF(effc++)
+	class OpCache
+	{
+	GCC_DIAG_ON(effc++)
+	private:  // data members
+
+		std::vector<OpEntry> entries_;
+
+	private:  // methods
+
+		OpEntry& slot(IdType lhs, IdType rhs)
+		{
+			if (entries_.empty())
+			{	// the table is allocated on the first use
+				entries_.resize(CACHE_SIZE, OpEntry());
+			}
+
+			uint64_t h = (static_cast<uint64_t>(lhs) << 32) | rhs;
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 33;
+
+			return entries_[static_cast<size_t>(h) & (CACHE_SIZE - 1)];
+		}
+
+	public:   // methods
+
+		OpCache() :
+			entries_()
+		{ }
+
+		bool Lookup(IdType lhs, IdType rhs, IdType& result)
+		{
+			assert(lhs < rhs);
+
+			const OpEntry& entry = slot(lhs, rhs);
+			if ((entry.lhs == lhs) && (entry.rhs == rhs))
+			{
+				result = entry.result;
+				return true;
+			}
+
+			return false;
+		}
+
+		void Insert(IdType lhs, IdType rhs, IdType result)
+		{
+			assert(lhs < rhs);
+
+			OpEntry& entry = slot(lhs, rhs);
+			entry.lhs = lhs;
+			entry.rhs = rhs;
+			entry.result = result;
+		}
+
+		void Clear()
+		{
+			std::vector<OpEntry>().swap(entries_);
+		}
+	};
+
+	GCC_DIAG_OFF(effc++)
+	struct Store
+	{
+	GCC_DIAG_ON(effc++)
+		ArenaCache<SetType> sets;
+		OpCache unionCache;
+		OpCache isectCache;
+
+		Store() :
+			sets(),
+			unionCache(),
+			isectCache()
+		{
+			internEmpty();
+		}
+
+		void internEmpty()
+		{
+			// the empty set has the ID 0
+			IdType emptyId = sets.lookupId(SetType());
+			assert(EMPTY_ID == emptyId);
+			(void)emptyId;
+		}
+	};
+
+private:  // constants
+
+	static const IdType EMPTY_ID = 0;
+
+	/**
+	 * @brief  The number of entries of an operation cache
+	 */
+	static const size_t CACHE_SIZE = size_t(1) << 14;
+
+private:  // data members
+
+	IdType id_;
+
+private:  // methods
+
+	static Store& store()
+	{
+		static thread_local Store store;
+		return store;
+	}
+
+	static InternedSet fromId(IdType id)
+	{
+		InternedSet result;
+		result.id_ = id;
+		return result;
+	}
+
+	static IdType computeUnion(const SetType& lhs, const SetType& rhs)
+	{
+		return store().sets.lookupId(lhs.Union(rhs));
+	}
+
+	static IdType computeIntersection(const SetType& lhs, const SetType& rhs)
+	{
+		std::vector<Key> isect;
+		std::set_intersection(lhs.begin(), lhs.end(),
+			rhs.begin(), rhs.end(), std::back_inserter(isect));
+
+		return store().sets.lookupId(SetType(isect));
+	}
+
+public:   // methods
+
+	/**
+	 * @brief  Creates the empty set
+	 */
+	InternedSet() :
+		id_(EMPTY_ID)
+	{ }
+
+	/**
+	 * @brief  Interns a set
+	 *
+	 * @param[in]  set  The set to be interned
+	 */
+	InternedSet(const SetType& set) :
+		id_(store().sets.lookupId(set))
+	{ }
+
+	/**
+	 * @brief  Interns a singleton set
+	 *
+	 * @param[in]  key  The only element of the set
+	 */
+	explicit InternedSet(const Key& key) :
+		id_(store().sets.lookupId(SetType(key)))
+	{ }
+
+	inline IdType GetId() const
+	{
+		return id_;
+	}
+
+	/**
+	 * @brief  Returns the interned set
+	 *
+	 * The reference stays valid until the store of the current thread is
+	 * reset or the thread terminates.
+	 */
+	inline const SetType& Get() const
+	{
+		// a set interned by another thread (or before a reset) may be out of range
+		assert(static_cast<size_t>(id_) < store().sets.size());
+
+		return store().sets[id_];
+	}
+
+	inline size_t size() const
+	{
+		return Get().size();
+	}
+
+	inline bool empty() const
+	{
+		return EMPTY_ID == id_;
+	}
+
+	inline const_iterator begin() const
+	{
+		return Get().begin();
+	}
+
+	inline const_iterator end() const
+	{
+		return Get().end();
+	}
+
+	inline const_iterator cbegin() const
+	{
+		return Get().cbegin();
+	}
+
+	inline const_iterator cend() const
+	{
+		return Get().cend();
+	}
+
+	inline const_iterator find(const Key& key) const
+	{
+		return Get().find(key);
+	}
+
+	inline const std::vector<Key>& ToVector() const
+	{
+		return Get().ToVector();
+	}
+
+	/**
+	 * @brief  Union of two sets (memoised)
+	 */
+	InternedSet Union(const InternedSet& rhs) const
+	{
+		if ((id_ == rhs.id_) || rhs.empty())
+		{
+			return *this;
+		}
+		else if (empty())
+		{
+			return rhs;
+		}
+
+		const IdType lhsId = std::min(id_, rhs.id_);
+		const IdType rhsId = std::max(id_, rhs.id_);
+
+		OpCache& cache = store().unionCache;
+		IdType result;
+		if (!cache.Lookup(lhsId, rhsId, result))
+		{	// in case the union is not cached
+			result = computeUnion(Get(), rhs.Get());
+			cache.Insert(lhsId, rhsId, result);
+		}
+
+		return fromId(result);
+	}
+
+	/**
+	 * @brief  Intersection of two sets (memoised)
+	 */
+	InternedSet Intersection(const InternedSet& rhs) const
+	{
+		if (id_ == rhs.id_)
+		{
+			return *this;
+		}
+		else if (empty() || rhs.empty())
+		{
+			return InternedSet();
+		}
+
+		const IdType lhsId = std::min(id_, rhs.id_);
+		const IdType rhsId = std::max(id_, rhs.id_);
+
+		OpCache& cache = store().isectCache;
+		IdType result;
+		if (!cache.Lookup(lhsId, rhsId, result))
+		{	// in case the intersection is not cached
+			result = computeIntersection(Get(), rhs.Get());
+			cache.Insert(lhsId, rhsId, result);
+		}
+
+		return fromId(result);
+	}
+
+	inline bool IsSubsetOf(const InternedSet& bigger) const
+	{
+		return (id_ == bigger.id_) || empty() || Get().IsSubsetOf(bigger.Get());
+	}
+
+	inline bool HaveEmptyIntersection(const InternedSet& rhs) const
+	{
+		return Intersection(rhs).empty();
+	}
+
+	inline bool operator==(const InternedSet& rhs) const
+	{
+		return id_ == rhs.id_;
+	}
+
+	inline bool operator!=(const InternedSet& rhs) const
+	{
+		return id_ != rhs.id_;
+	}
+
+	/**
+	 * @brief  Ordering of sets by their IDs
+	 *
+	 * The ordering is total, but it is not the lexicographical ordering of
+	 * OrdVector.
+	 */
+	inline bool operator<(const InternedSet& rhs) const
+	{
+		return id_ < rhs.id_;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const InternedSet& set)
+	{
+		return os << set.Get();
+	}
+
+	friend size_t hash_value(const InternedSet& set)
+	{
+		return boost::hash<IdType>()(set.id_);
+	}
+
+	/**
+	 * @brief  The number of sets interned in the current thread
+	 */
+	static size_t GetSetCount()
+	{
+		return store().sets.size();
+	}
+
+	/**
+	 * @brief  Releases all sets interned in the current thread
+	 *
+	 * All objects of the class in the current thread other than the empty set
+	 * (including leaves of MTBDDs) become invalid, so the store may only be
+	 * reset when no such object is in use.
+	 */
+	static void Reset()
+	{
+		Store& st = store();
+
+		st.unionCache.Clear();
+		st.isectCache.Clear();
+		st.sets.clear();
+		st.internEmpty();
+	}
+};
+
+#endif
@@ -17,6 +17,7 @@
 // VATA headers
 #include <vata/vata.hh>
 
+#include "../util/bit_vector.hh"
 #include "../util/caching_allocator.hh"
 
 namespace VATA
@@ -215,6 +216,11 @@ public:
 
 public:
 
+	/**
+	 * @brief  Erasing an element modifies its neighbours in other rows
+	 */
+	static const bool ConcurrentRows = false;
+
 	SplittingRelation(size_t maxSize) : columns_(maxSize), rows_(maxSize), size_(), allocator_() {}
 
 	~SplittingRelation() {
@@ -418,6 +424,49 @@ public:
 
 	}
 
+	/**
+	 * @brief  Calls @p f with every column related to the row @p index
+	 */
+	template <class F>
+	void forEach(size_t index, F f) {
+
+		for (auto col : this->row(index))
+			f(col);
+
+	}
+
+	/**
+	 * @brief  Removes the columns in @p mask from the row @p index
+	 *
+	 * The functor @p f is called with every removed column.
+	 */
+	template <class F>
+	void eraseMasked(size_t index, const BitVector& mask, F f) {
+
+		auto row = this->row(index);
+
+		for (auto col = row.begin(); col != row.end(); ++col) {
+
+			if (!mask[*col])
+				continue;
+
+			size_t j = *col;
+
+			this->erase(col);
+
+			f(j);
+
+		}
+
+	}
+
+	template <class F>
+	void eraseMasked(size_t index, const BitVector& mask, F f, std::vector<BitVector::Word>&) {
+
+		this->eraseMasked(index, mask, f);
+
+	}
+
 	const size_t& size() const {
 
 		return this->size_;
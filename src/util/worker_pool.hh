@@ -0,0 +1,199 @@
+/*****************************************************************************
+ *  VATA Tree Automata Library
+ *
+ *  Copyright (c) 2014  Ondra Lengal <ilengal@fit.vutbr.cz>
+ *
+ *  Description:
+ *    Pool of worker threads for data-parallel loops.
+ *
+ *****************************************************************************/
+
+#ifndef _VATA_WORKER_POOL_HH_
+#define _VATA_WORKER_POOL_HH_
+
+// Standard library headers
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// VATA headers
+#include <vata/vata.hh>
+
+
+// insert class to proper namespace
+namespace VATA { namespace Util {
+	class WorkerPool;
+}}
+
+
+/**
+ * @brief  A pool of threads executing parallel loops
+ *
+ * The threads are created once and sleep between the loops, so the pool is
+ * cheap enough to be used for many short loops. The calling thread takes part
+ * in every loop as the worker 0; the other threads are the workers 1 to
+ * size() - 1. Only one loop may run at a time.
+ */
+class VATA::Util::WorkerPool
+{
+public:   // data types
+
+	/**
+	 * @brief  Body of a loop, called with the iteration and the worker number
+	 */
+	using LoopBody         = std::function<void(size_t, size_t)>;
+
+private:  // data members
+
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable startCond_;
+	std::condition_variable doneCond_;
+
+	const LoopBody* body_;
+	size_t iterations_;
+	std::atomic<size_t> next_;
+
+	size_t generation_;
+	size_t running_;
+	bool stop_;
+
+private:  // methods
+
+	WorkerPool(const WorkerPool&);
+	WorkerPool& operator=(const WorkerPool&);
+
+	void work(size_t worker)
+	{
+		for (size_t i = next_++; i < iterations_; i = next_++)
+		{
+			(*body_)(i, worker);
+		}
+	}
+
+	void threadMain(size_t worker)
+	{
+		size_t generation = 0;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+
+				startCond_.wait(lock,
+					[this, generation]{ return stop_ || (generation_ != generation); });
+
+				if (stop_)
+				{
+					return;
+				}
+
+				generation = generation_;
+			}
+
+			this->work(worker);
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (0 == --running_)
+			{
+				doneCond_.notify_one();
+			}
+		}
+	}
+
+public:   // methods
+
+	/**
+	 * @brief  Creates the pool
+	 *
+	 * @param[in]  threadCnt  The number of threads including the calling one;
+	 *                        0 stands for the number of hardware threads
+	 */
+	explicit WorkerPool(size_t threadCnt) :
+		threads_(),
+		mutex_(),
+		startCond_(),
+		doneCond_(),
+		body_(nullptr),
+		iterations_(0),
+		next_(0),
+		generation_(0),
+		running_(0),
+		stop_(false)
+	{
+		if (0 == threadCnt)
+		{
+			threadCnt = std::thread::hardware_concurrency();
+		}
+
+		for (size_t i = 1; i < threadCnt; ++i)
+		{
+			threads_.push_back(std::thread(&WorkerPool::threadMain, this, i));
+		}
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+
+		startCond_.notify_all();
+
+		for (std::thread& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	/**
+	 * @brief  The number of workers (including the calling thread)
+	 */
+	size_t size() const
+	{
+		return threads_.size() + 1;
+	}
+
+	/**
+	 * @brief  Calls @p body for all iterations from 0 to @p iterations - 1
+	 *
+	 * The iterations are distributed dynamically among the workers. The call
+	 * returns after all iterations are finished.
+	 */
+	void Run(size_t iterations, const LoopBody& body)
+	{
+		if (threads_.empty() || (iterations <= 1))
+		{
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				body(i, 0);
+			}
+
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			body_ = &body;
+			iterations_ = iterations;
+			next_ = 0;
+			running_ = threads_.size();
+			++generation_;
+		}
+
+		startCond_.notify_all();
+
+		this->work(0);
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCond_.wait(lock, [this]{ return 0 == running_; });
+	}
+};
+
+#endif
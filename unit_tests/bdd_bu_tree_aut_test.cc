@@ -13,6 +13,7 @@
 #include <vata/bdd_bu_tree_aut.hh>
 
 #include <vata/bdd_td_tree_aut.hh>
+#include <vata/explicit_tree_aut.hh>
 
 // testing headers
 #include "log_fixture.hh"
@@ -108,4 +109,71 @@ BOOST_AUTO_TEST_CASE(aut_up_inclusion)
 	testInclusion(ip);
 }
 
+BOOST_AUTO_TEST_CASE(aut_up_inclusion_threads)
+{
+	VATA::InclParam ip;
+	ip.SetDirection(InclParam::e_direction::upward);
+	ip.SetThreadCount(4);
+	testInclusion(ip);
+}
+
+BOOST_AUTO_TEST_CASE(explicit_conversion)
+{
+	typedef VATA::ExplicitTreeAut ExplicitAut;
+
+	const ExplicitAut::SymbolType a = 0, b = 1, f = 2;
+
+	AutType::ExplicitSymbolEncoding encoding;
+	for (ExplicitAut::SymbolType symbol : {a, b, f})
+	{
+		encoding.insert(std::make_pair(symbol, AutType::SymbolType(16, symbol)));
+	}
+
+	ExplicitAut explAut;
+	explAut.AddTransition(AutType::StateTuple(), a, 1);
+	explAut.AddTransition(AutType::StateTuple(), b, 2);
+	explAut.AddTransition(AutType::StateTuple(), b, 1);
+	explAut.AddTransition(AutType::StateTuple({1, 2}), f, 3);
+	explAut.AddTransition(AutType::StateTuple({1}), f, 3);
+	explAut.SetStateFinal(3);
+
+	size_t transCnt = 0;
+	for (auto it = explAut.begin(); it != explAut.end(); ++it)
+	{
+		++transCnt;
+	}
+
+	AutType symbAut;
+	for (const ExplicitAut::Transition& trans : explAut)
+	{
+		symbAut.AddTransition(trans.GetChildren(),
+			encoding.at(trans.GetSymbol()), trans.GetParent());
+	}
+	symbAut.SetStateFinal(3);
+
+	InclParam ip;
+	ip.SetDirection(InclParam::e_direction::upward);
+
+	AutType convAut = AutType::FromExplicit(explAut, encoding);
+	BOOST_CHECK(AutType::CheckInclusion(convAut, symbAut, ip));
+	BOOST_CHECK(AutType::CheckInclusion(symbAut, convAut, ip));
+
+	AutTypeInverted convTDAut = AutTypeInverted::FromExplicit(explAut, encoding);
+
+	for (const ExplicitAut& backAut :
+		{convAut.ToExplicit(encoding), convTDAut.ToExplicit(encoding)})
+	{
+		size_t backTransCnt = 0;
+		for (const ExplicitAut::Transition& trans : backAut)
+		{
+			BOOST_CHECK(explAut.ContainsTransition(trans));
+			++backTransCnt;
+		}
+
+		BOOST_CHECK_EQUAL(transCnt, backTransCnt);
+		BOOST_CHECK(backAut.IsStateFinal(3));
+		BOOST_CHECK(!backAut.IsStateFinal(1));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
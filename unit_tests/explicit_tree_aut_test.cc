@@ -11,6 +11,10 @@
 // VATA headers
 #include <vata/vata.hh>
 #include <vata/explicit_tree_aut.hh>
+#include <vata/context.hh>
+
+// Standard library headers
+#include <thread>
 
 #include "log_fixture.hh"
 
@@ -387,4 +391,519 @@ BOOST_AUTO_TEST_CASE(translate_symbols)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(frozen_contains_transition)
+{
+	this->runOnAutomataSet(
+		[](const AutType& aut, const StateDict& stateDict, const std::string& filename)
+		{
+			BOOST_MESSAGE("Checking frozen transitions for " + filename + "...");
+
+			AutType frozenAut(aut);
+			frozenAut.Freeze();
+			BOOST_REQUIRE(frozenAut.IsFrozen());
+
+			for (const Transition& trans : aut)
+			{
+				BOOST_REQUIRE_MESSAGE(frozenAut.ContainsTransition(trans),
+					"Inconsistent frozen table: " + aut.ToString(trans) +
+					" is claimed not to be in aut");
+			}
+
+			for (const Transition& trans : frozenAut)
+			{
+				BOOST_REQUIRE_MESSAGE(aut.ContainsTransition(trans),
+					"Inconsistent frozen table: " + aut.ToString(trans) +
+					" is claimed to be in aut");
+			}
+
+			frozenAut.AddTransition(StateTuple(), 0, 0);
+			BOOST_REQUIRE(!frozenAut.IsFrozen());
+		});
+}
+
+BOOST_AUTO_TEST_CASE(aut_intersection_frozen)
+{
+	auto testfileContent = ParseTestFile(INTERSECTION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputLhsFile = (AUT_DIR / testcase[0]).string();
+		std::string inputRhsFile = (AUT_DIR / testcase[1]).string();
+		std::string resultFile = (AUT_DIR / testcase[2]).string();
+
+		BOOST_MESSAGE("Performing frozen intersection of " + inputLhsFile + " and "
+			+ inputRhsFile + "...");
+
+		std::string autLhsStr = VATA::Util::ReadFile(inputLhsFile);
+		std::string autRhsStr = VATA::Util::ReadFile(inputRhsFile);
+		std::string autCorrectStr = VATA::Util::ReadFile(resultFile);
+
+		StateDict stateDictLhs;
+		AutType autLhs;
+		readAut(autLhs, stateDictLhs, autLhsStr);
+		autLhs.Freeze();
+
+		StateDict stateDictRhs;
+		AutType autRhs;
+		readAut(autRhs, stateDictRhs, autRhsStr);
+		autRhs.Freeze();
+
+		AutBase::ProductTranslMap translMap;
+		AutType autIntersect = AutType::Intersection(autLhs, autRhs, &translMap);
+
+		StateDict stateDictIsect = VATA::Util::CreateProductStringToStateMap(
+			stateDictLhs, stateDictRhs, translMap);
+
+		std::string autIntersectStr = dumpAut(autIntersect, stateDictIsect);
+
+		AutDescription descOut = parser_.ParseString(autIntersectStr);
+		AutDescription descCorrect = parser_.ParseString(autCorrectStr);
+
+		BOOST_CHECK_MESSAGE(descOut == descCorrect,
+			"\n\nExpecting:\n===========\n" + autCorrectStr +
+			"===========\n\nGot:\n===========\n" + autIntersectStr + "\n===========");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aut_remove_useless_frozen)
+{
+	auto testfileContent = ParseTestFile(USELESS_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 2, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputFile = (AUT_DIR / testcase[0]).string();
+		std::string resultFile = (AUT_DIR / testcase[1]).string();
+
+		BOOST_MESSAGE("Removing useless states from frozen " + inputFile + "...");
+
+		std::string autStr = VATA::Util::ReadFile(inputFile);
+		std::string autCorrectStr = VATA::Util::ReadFile(resultFile);
+
+		StateDict stateDict;
+		AutType aut;
+		readAut(aut, stateDict, autStr);
+		aut.Freeze();
+
+		AutType autNoUseless = aut.RemoveUselessStates();
+		std::string autNoUselessStr = dumpAut(autNoUseless, stateDict);
+
+		AutDescription descOutNoUseless = parser_.ParseString(autNoUselessStr);
+		AutDescription descCorrectNoUseless = parser_.ParseString(autCorrectStr);
+
+		BOOST_CHECK_MESSAGE(descCorrectNoUseless == descOutNoUseless,
+			"\n\nExpecting:\n===========\n" +
+			serializer_.Serialize(descCorrectNoUseless) +
+			"===========\n\nGot:\n===========\n" + autNoUselessStr + "\n===========");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aut_remove_useless_index_invalidation)
+{
+	AutType aut;
+	aut.AddTransition(StateTuple({1, 1}), 0, 2);
+	aut.SetStateFinal(2);
+
+	// builds the bottom-up index of aut
+	AutType autNoUseless = aut.RemoveUselessStates();
+	BOOST_REQUIRE(!autNoUseless.ContainsTransition(StateTuple({1, 1}), 0, 2));
+
+	// the index needs to be dropped, otherwise the new leaf is not seen
+	aut.AddTransition(StateTuple(), 1, 1);
+
+	autNoUseless = aut.RemoveUselessStates();
+	BOOST_CHECK(autNoUseless.ContainsTransition(StateTuple(), 1, 1));
+	BOOST_CHECK(autNoUseless.ContainsTransition(StateTuple({1, 1}), 0, 2));
+}
+
+BOOST_AUTO_TEST_CASE(state_tuple_inline_storage)
+{
+	StateTuple small({1, 2, 3});
+	BOOST_CHECK_EQUAL(small.capacity(), 3);
+
+	// tuples of a bigger rank are moved to the heap
+	StateTuple big(small);
+	big.push_back(4);
+	big.insert(big.begin(), big.begin(), big.begin() + 2);
+	BOOST_REQUIRE_EQUAL(big.size(), 6);
+	BOOST_CHECK(big == StateTuple({1, 2, 1, 2, 3, 4}));
+	BOOST_CHECK(big < small);
+
+	AutType aut;
+	aut.AddTransition(small, 0, 5);
+	aut.AddTransition(big, 1, 5);
+
+	BOOST_CHECK(aut.ContainsTransition(StateTuple({1, 2, 3}), 0, 5));
+	BOOST_CHECK(aut.ContainsTransition(StateTuple({1, 2, 1, 2, 3, 4}), 1, 5));
+	BOOST_CHECK(!aut.ContainsTransition(StateTuple({1, 2, 1, 2, 3}), 1, 5));
+}
+
+BOOST_AUTO_TEST_CASE(state_tuple_std_vector)
+{
+	// code written for tuples stored in std::vector keeps working
+	std::vector<AutType::StateType> children = {1, 2, 3, 4};
+
+	AutType aut;
+	aut.AddTransition(children, 0, 5);
+	BOOST_CHECK(aut.ContainsTransition(children, 0, 5));
+
+	for (const AutType::Transition& trans : aut)
+	{
+		std::vector<AutType::StateType> transChildren = trans.GetChildren();
+		BOOST_CHECK(transChildren == children);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aut_simulation_parallel)
+{
+	auto testfileContent = ParseTestFile(DOWN_SIM_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 2, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputFile = (AUT_DIR / testcase[0]).string();
+
+		BOOST_MESSAGE("Computing parallel simulations for " + inputFile + "...");
+
+		StateDict stateDict;
+		AutType aut;
+		readAut(aut, stateDict, VATA::Util::ReadFile(inputFile));
+
+		StateType stateCnt = 0;
+		StateToStateMap stateMap;
+		StateToStateTranslWeak stateTrans(stateMap,
+			[&stateCnt](const StateType&){return stateCnt++;});
+
+		AutType reindexedAut = aut.RemoveUselessStates().ReindexStates(stateTrans);
+
+		for (auto relation : {
+			VATA::SimParam::e_sim_relation::TA_DOWNWARD,
+			VATA::SimParam::e_sim_relation::TA_UPWARD})
+		{
+			SimParam sp;
+			sp.SetRelation(relation);
+			sp.SetNumStates(stateCnt);
+			StateBinaryRelation sim = reindexedAut.ComputeSimulation(sp);
+
+			sp.SetThreadCount(4);
+			StateBinaryRelation parSim = reindexedAut.ComputeSimulation(sp);
+
+			BOOST_REQUIRE_EQUAL(sim.size(), parSim.size());
+			for (size_t i = 0; i < sim.size(); ++i)
+			{
+				for (size_t j = 0; j < sim.size(); ++j)
+				{
+					BOOST_CHECK(sim.get(i, j) == parSim.get(i, j));
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aut_simulation_parallel_refine)
+{
+	// a pseudo-random automaton big enough for the pre-lists of the simulation
+	// algorithm to be refined in parallel (the test automata are too small)
+	const size_t stateCnt = 32;
+	const size_t transCnt = 100;
+
+	uint64_t seed = 42;
+	auto random = [&seed]() -> size_t
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return static_cast<size_t>(seed >> 33);
+	};
+
+	AutType aut;
+	for (size_t i = 0; i < transCnt; ++i)
+	{
+		// the rank of the symbol a is a % 3
+		SymbolType symbol = random() % 4;
+
+		StateTuple children;
+		for (size_t j = 0; j < symbol % 3; ++j)
+		{
+			children.push_back(random() % stateCnt);
+		}
+
+		aut.AddTransition(children, symbol, random() % stateCnt);
+	}
+
+	aut.SetStateFinal(0);
+
+	StateType reindexedCnt = 0;
+	StateToStateMap stateMap;
+	StateToStateTranslWeak stateTrans(stateMap,
+		[&reindexedCnt](const StateType&){return reindexedCnt++;});
+
+	AutType reindexedAut = aut.RemoveUselessStates().ReindexStates(stateTrans);
+
+	for (auto relation : {
+		VATA::SimParam::e_sim_relation::TA_DOWNWARD,
+		VATA::SimParam::e_sim_relation::TA_UPWARD})
+	{
+		SimParam sp;
+		sp.SetRelation(relation);
+		sp.SetNumStates(reindexedCnt);
+		StateBinaryRelation sim = reindexedAut.ComputeSimulation(sp);
+
+		sp.SetThreadCount(4);
+		StateBinaryRelation parSim = reindexedAut.ComputeSimulation(sp);
+
+		BOOST_REQUIRE_EQUAL(sim.size(), parSim.size());
+		for (size_t i = 0; i < sim.size(); ++i)
+		{
+			for (size_t j = 0; j < sim.size(); ++j)
+			{
+				BOOST_CHECK(sim.get(i, j) == parSim.get(i, j));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(binary_relation_word_operations)
+{
+	// a chain 0 -> 1 -> ... -> 99 crossing word boundaries, with 70 ~ 71
+	const size_t size = 100;
+	StateBinaryRelation rel(size);
+	for (size_t i = 0; i + 1 < size; ++i)
+	{
+		rel.set(i, i + 1, true);
+	}
+	rel.set(71, 70, true);
+
+	StateBinaryRelation trans;
+	rel.transposed(trans);
+	BOOST_CHECK(trans.get(1, 0) && trans.get(70, 71) && trans.get(71, 70));
+	BOOST_CHECK(!trans.get(0, 1));
+	BOOST_CHECK_EQUAL(trans.count(), size);
+
+	rel.closure();
+	for (size_t i = 0; i < size; ++i)
+	{
+		BOOST_CHECK_EQUAL(rel.rowCount(i), (i <= 71)? (size - std::min(i, size_t(70))) : (size - i));
+	}
+	BOOST_CHECK(rel.isRowSubset(99, 0));
+	BOOST_CHECK(!rel.isRowSubset(0, 99));
+
+	std::vector<size_t> index;
+	std::vector<size_t> head;
+	rel.buildClasses(index, head);
+	BOOST_REQUIRE_EQUAL(head.size(), size - 1);
+	BOOST_CHECK_EQUAL(index[70], index[71]);
+	BOOST_CHECK_EQUAL(head[index[71]], 70);
+}
+
+BOOST_AUTO_TEST_CASE(aut_intersection_parallel)
+{
+	auto testfileContent = ParseTestFile(INTERSECTION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputLhsFile = (AUT_DIR / testcase[0]).string();
+		std::string inputRhsFile = (AUT_DIR / testcase[1]).string();
+		std::string resultFile = (AUT_DIR / testcase[2]).string();
+
+		BOOST_MESSAGE("Performing parallel intersection of " + inputLhsFile + " and "
+			+ inputRhsFile + "...");
+
+		std::string autLhsStr = VATA::Util::ReadFile(inputLhsFile);
+		std::string autRhsStr = VATA::Util::ReadFile(inputRhsFile);
+		std::string autCorrectStr = VATA::Util::ReadFile(resultFile);
+
+		StateDict stateDictLhs;
+		AutType autLhs;
+		readAut(autLhs, stateDictLhs, autLhsStr);
+
+		StateDict stateDictRhs;
+		AutType autRhs;
+		readAut(autRhs, stateDictRhs, autRhsStr);
+
+		AutBase::ProductTranslMap translMap;
+		AutType autIntersect = AutType::Intersection(autLhs, autRhs, &translMap, 4);
+
+		StateDict stateDictIsect = VATA::Util::CreateProductStringToStateMap(
+			stateDictLhs, stateDictRhs, translMap);
+
+		std::string autIntersectStr = dumpAut(autIntersect, stateDictIsect);
+
+		AutDescription descOut = parser_.ParseString(autIntersectStr);
+		AutDescription descCorrect = parser_.ParseString(autCorrectStr);
+
+		BOOST_CHECK_MESSAGE(descOut == descCorrect,
+			"\n\nExpecting:\n===========\n" + autCorrectStr +
+			"===========\n\nGot:\n===========\n" + autIntersectStr + "\n===========");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(aut_intersection_emptiness)
+{
+	auto testfileContent = ParseTestFile(INTERSECTION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputLhsFile = (AUT_DIR / testcase[0]).string();
+		std::string inputRhsFile = (AUT_DIR / testcase[1]).string();
+
+		BOOST_MESSAGE("Checking emptiness of intersection of " + inputLhsFile + " and "
+			+ inputRhsFile + "...");
+
+		AutType autLhs;
+		readAut(autLhs, VATA::Util::ReadFile(inputLhsFile));
+
+		AutType autRhs;
+		readAut(autRhs, VATA::Util::ReadFile(inputRhsFile));
+
+		bool expected = AutType::Intersection(autLhs, autRhs, nullptr)
+			.RemoveUselessStates().GetFinalStates().empty();
+
+		AutType witness;
+		bool isEmpty = AutType::IsIntersectionEmpty(autLhs, autRhs, &witness);
+
+		BOOST_CHECK_MESSAGE(expected == isEmpty,
+			"Invalid emptiness of intersection of " + inputLhsFile + " and " +
+			inputRhsFile + ": got " + Convert::ToString(isEmpty));
+
+		std::vector<const AutType*> auts;
+		auts.push_back(&autLhs);
+		auts.push_back(&autRhs);
+		auts.push_back(&autLhs);
+
+		BOOST_CHECK_MESSAGE(expected == AutType::IsIntersectionEmpty(auts),
+			"Invalid emptiness of ternary intersection of " + inputLhsFile + " and " +
+			inputRhsFile);
+
+		if (!isEmpty)
+		{
+			BOOST_CHECK_MESSAGE(!witness.RemoveUselessStates().GetFinalStates().empty(),
+				"Empty witness for " + inputLhsFile + " and " + inputRhsFile);
+
+			VATA::InclParam ip;
+			ip.SetDirection(InclParam::e_direction::downward);
+
+			BOOST_CHECK_MESSAGE(AutType::CheckInclusion(witness, autLhs, ip) &&
+				AutType::CheckInclusion(witness, autRhs, ip),
+				"Invalid witness for " + inputLhsFile + " and " + inputRhsFile);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(context_threads)
+{
+	const size_t THREAD_CNT = 4;
+
+	auto testfileContent = ParseTestFile(INTERSECTION_TIMBUK_FILE.string());
+
+	for (auto testcase : testfileContent)
+	{
+		BOOST_REQUIRE_MESSAGE(testcase.size() == 3, "Invalid format of a testcase: " +
+			Convert::ToString(testcase));
+
+		std::string inputLhsFile = (AUT_DIR / testcase[0]).string();
+		std::string inputRhsFile = (AUT_DIR / testcase[1]).string();
+		std::string resultFile = (AUT_DIR / testcase[2]).string();
+
+		BOOST_MESSAGE("Performing intersection, inclusion and removal of useless "
+			"states on " + inputLhsFile + " and " + inputRhsFile +
+			" in several contexts...");
+
+		// the parser is not reentrant, so parse in this thread
+		AutDescription descLhs = parser_.ParseString(VATA::Util::ReadFile(inputLhsFile));
+		AutDescription descRhs = parser_.ParseString(VATA::Util::ReadFile(inputRhsFile));
+		AutDescription descCorrect = parser_.ParseString(VATA::Util::ReadFile(resultFile));
+
+		std::vector<AutDescription> results(THREAD_CNT);
+		std::vector<AutDescription> usefulResults(THREAD_CNT);
+		std::vector<char> inclResults(THREAD_CNT, false);
+		std::vector<std::thread> threads;
+
+		for (size_t i = 0; i < THREAD_CNT; ++i)
+		{
+			threads.push_back(std::thread([&, i]()
+				{
+					VATA::Context context;
+
+					StateDict stateDictLhs;
+					AutType autLhs(context);
+					autLhs.LoadFromAutDesc(descLhs, stateDictLhs);
+
+					StateDict stateDictRhs;
+					AutType autRhs(context);
+					autRhs.LoadFromAutDesc(descRhs, stateDictRhs);
+
+					AutBase::ProductTranslMap translMap;
+					AutType autIntersect = AutType::Intersection(autLhs, autRhs, &translMap);
+
+					StateDict stateDictIsect = VATA::Util::CreateProductStringToStateMap(
+						stateDictLhs, stateDictRhs, translMap);
+
+					results[i] = autIntersect.DumpToAutDesc(stateDictIsect);
+
+					VATA::InclParam ip;
+					ip.SetDirection(InclParam::e_direction::downward);
+					inclResults[i] = AutType::CheckInclusion(autIntersect, autLhs, ip) &&
+						AutType::CheckInclusion(autIntersect, autRhs, ip);
+
+					AutType autUseful = autIntersect.RemoveUselessStates();
+					usefulResults[i] = autUseful.DumpToAutDesc(stateDictIsect);
+				}));
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (const AutDescription& descOut : results)
+		{
+			BOOST_CHECK_MESSAGE(descOut == descCorrect,
+				"\n\nExpecting:\n===========\n" + serializer_.Serialize(descCorrect) +
+				"===========\n\nGot:\n===========\n" + serializer_.Serialize(descOut) +
+				"\n===========");
+		}
+
+		// the reference result of the removal of useless states is computed
+		// without a context
+		StateDict stateDictLhs;
+		AutType autLhs;
+		autLhs.LoadFromAutDesc(descLhs, stateDictLhs);
+
+		StateDict stateDictRhs;
+		AutType autRhs;
+		autRhs.LoadFromAutDesc(descRhs, stateDictRhs);
+
+		AutBase::ProductTranslMap translMap;
+		AutType autIntersect = AutType::Intersection(autLhs, autRhs, &translMap);
+		StateDict stateDictIsect = VATA::Util::CreateProductStringToStateMap(
+			stateDictLhs, stateDictRhs, translMap);
+		AutDescription descUseful =
+			autIntersect.RemoveUselessStates().DumpToAutDesc(stateDictIsect);
+
+		for (size_t i = 0; i < THREAD_CNT; ++i)
+		{
+			BOOST_CHECK_MESSAGE(inclResults[i],
+				"Intersection not included in its operands in thread " +
+				Convert::ToString(i));
+
+			BOOST_CHECK_MESSAGE(usefulResults[i] == descUseful,
+				"\n\nExpecting:\n===========\n" + serializer_.Serialize(descUseful) +
+				"===========\n\nGot:\n===========\n" +
+				serializer_.Serialize(usefulResults[i]) + "\n===========");
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
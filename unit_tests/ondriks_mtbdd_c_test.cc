@@ -17,12 +17,19 @@
 #include "../src/mtbdd/apply1func.hh"
 #include "../src/mtbdd/apply2func.hh"
 #include "../src/mtbdd/apply3func.hh"
+#include "../src/mtbdd/bool_apply2func.hh"
+#include "../src/mtbdd/computed_table.hh"
 #include "../src/mtbdd/ondriks_mtbdd.hh"
+#include "../src/util/interned_set.hh"
+
+// standard library headers
+#include <thread>
 
 using VATA::MTBDDPkg::OndriksMTBDD;
 using VATA::MTBDDPkg::Apply1Functor;
 using VATA::MTBDDPkg::Apply2Functor;
 using VATA::MTBDDPkg::Apply3Functor;
+using VATA::MTBDDPkg::ComputedTable;
 using VATA::Util::Convert;
 
 
@@ -310,6 +317,19 @@ public:   // public methods
 
 protected:// protected methods
 
+	/**
+	 * @brief  Returns the number of known variables
+	 *
+	 * Returns the number of variables that have been assigned an index.
+	 *
+	 * @returns  Number of known variables
+	 */
+	unsigned getVarCount() const
+	{
+		return varCounter_;
+	}
+
+
 	/**
 	 * @brief  Loads standard tests
 	 *
@@ -439,6 +459,29 @@ protected:// protected methods
 
 		return bdd;
 	}
+
+	/**
+	 * @brief  Addition sharing its results through the computed table
+	 *
+	 * Local classes may not have static data members, so the functor is
+	 * defined here.
+	 */
+	GCC_DIAG_OFF(effc++)
+	class SharedAdditionApplyFunctor :
+		public Apply2Functor<SharedAdditionApplyFunctor, DataType, DataType,
+		DataType>
+	{
+	GCC_DIAG_ON(effc++)
+
+	public:
+
+		static const bool SHARED_CACHE = true;
+
+		inline DataType ApplyOperation(const DataType& lhs, const DataType& rhs)
+		{
+			return lhs + rhs;
+		}
+	};
 };
 
 
@@ -967,4 +1010,659 @@ BOOST_AUTO_TEST_CASE(equality)
 }
 
 
+BOOST_AUTO_TEST_CASE(node_release_and_reuse)
+{
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	MTBDD::CollectGarbage();
+	const size_t nodeCount = MTBDD::GetNodeCount();
+
+	for (size_t i = 0; i < 2; ++i)
+	{	// the second round reuses the nodes released by the first one
+		std::vector<MTBDD> bdds;
+		for (const std::string& testCase : testCases)
+		{
+			FormulaParser::ParserResultUnsignedType prsRes =
+				FormulaParser::ParseExpressionUnsigned(testCase);
+			bdds.push_back(MTBDD(varListToAsgn(prsRes.second),
+				static_cast<DataType>(prsRes.first), DEFAULT_DATA_VALUE));
+		}
+
+		BOOST_CHECK(MTBDD::GetNodeCount() > nodeCount);
+
+		// equal formulae share their nodes
+		BOOST_CHECK(bdds[3] == bdds[4]);
+		BOOST_CHECK(bdds[3] != bdds[5]);
+	}
+
+	MTBDD::CollectGarbage();
+	BOOST_CHECK_EQUAL(MTBDD::GetNodeCount(), nodeCount);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_garbage_collection)
+{
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	MTBDD::CollectGarbage();
+	const size_t nodeCount = MTBDD::GetNodeCount();
+
+	size_t liveCount = 0;
+	{
+		MTBDD bdd = createMTBDDForTestCases(testCases);
+		liveCount = MTBDD::GetNodeCount();
+	}
+
+	// released nodes stay until they are collected
+	BOOST_CHECK_EQUAL(MTBDD::GetNodeCount(), liveCount);
+
+	{	// dead nodes are reused
+		MTBDD bdd = createMTBDDForTestCases(testCases);
+		BOOST_CHECK_EQUAL(MTBDD::GetNodeCount(), liveCount);
+	}
+
+	MTBDD::CollectGarbage();
+	BOOST_CHECK_EQUAL(MTBDD::GetNodeCount(), nodeCount);
+
+	// with the threshold of one node, garbage is collected immediately
+	MTBDD::SetGarbageCollectionThreshold(1);
+	{
+		MTBDD bdd = createMTBDDForTestCases(testCases);
+	}
+
+	BOOST_CHECK_EQUAL(MTBDD::GetNodeCount(), nodeCount);
+	MTBDD::SetGarbageCollectionThreshold(1 << 14);
+}
+
+
+BOOST_AUTO_TEST_CASE(computed_table_sharing)
+{
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	std::vector<VarAsgn> asgns;
+	for (const std::string& testCase : testCases)
+	{
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(testCase);
+		asgns.push_back(varListToAsgn(prsRes.second));
+	}
+
+	std::vector<DataType> expected;
+	for (size_t round = 0; round < 2; ++round)
+	{	// the second round runs after all nodes of the first one were released
+		SharedAdditionApplyFunctor adder;
+		MTBDD bdd = createMTBDDForTestCases(testCases);
+
+		MTBDD sum = adder(bdd, bdd);
+
+		size_t hits = ComputedTable::GetHitCount();
+		MTBDD sumAgain = adder(bdd, bdd);
+
+		// the second call is answered by the computed table
+		BOOST_CHECK(ComputedTable::GetHitCount() > hits);
+		BOOST_CHECK(sum == sumAgain);
+
+		for (size_t i = 0; i < asgns.size(); ++i)
+		{
+			DataType value = sum.GetValue(asgns[i]);
+			BOOST_CHECK_EQUAL(value, static_cast<DataType>(2 * bdd.GetValue(asgns[i])));
+
+			if (round == 0)
+			{
+				expected.push_back(value);
+			}
+			else
+			{	// stale entries of the first round must not be used
+				BOOST_CHECK_EQUAL(value, expected[i]);
+			}
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(sifting)
+{
+	GCC_DIAG_OFF(effc++)
+	class MaxApplyFunctor :
+		public Apply2Functor<MaxApplyFunctor, DataType, DataType, DataType>
+	{
+	GCC_DIAG_ON(effc++)
+
+	public:
+
+		inline DataType ApplyOperation(const DataType& lhs, const DataType& rhs)
+		{
+			return std::max(lhs, rhs);
+		}
+	};
+
+	// x0 & x3 | x1 & x4 | x2 & x5 is large with the identity ordering
+	const size_t varCount = 6;
+	const size_t pairCount = varCount / 2;
+
+	MaxApplyFunctor maxFunc;
+	MTBDD bdd(DEFAULT_DATA_VALUE);
+	for (size_t i = 0; i < pairCount; ++i)
+	{
+		VarAsgn asgn(varCount);
+		asgn.SetIthVariableValue(i, VarAsgn::ONE);
+		asgn.SetIthVariableValue(i + pairCount, VarAsgn::ONE);
+
+		bdd = maxFunc(bdd, MTBDD(asgn, 1, DEFAULT_DATA_VALUE));
+	}
+
+	MTBDD sifted = bdd;
+	MTBDD::ReorderingResult result =
+		MTBDD::Sift(std::vector<MTBDD*>({&sifted}));
+
+	BOOST_CHECK_EQUAL(result.nodesBefore,
+		MTBDD::CountNodes(std::vector<const MTBDD*>({&bdd})));
+	BOOST_CHECK_EQUAL(result.nodesAfter,
+		MTBDD::CountNodes(std::vector<const MTBDD*>({&sifted})));
+	BOOST_CHECK(result.nodesAfter < result.nodesBefore);
+
+	for (size_t n = 0; n < (1 << varCount); ++n)
+	{	// the reordered MTBDD represents the same function
+		VarAsgn asgn(varCount, n);
+		BOOST_CHECK_EQUAL(bdd.GetValue(asgn),
+			sifted.GetValue(MTBDD::PermuteAsgn(asgn, *result.permutation)));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(var_asgn_packed_operations)
+{
+	boost::mt19937 prnGen(PRNG_SEED);
+
+	// rank of values in the ordering of assignments
+	auto rank = [](char c){ return (c == '0')? 0 : ((c == 'X')? 1 : 2); };
+
+	for (size_t round = 0; round < 200; ++round)
+	{	// lengths cross the boundary of words
+		size_t length = prnGen() % 80;
+		std::string lhsStr, rhsStr;
+		size_t dontCares = 0;
+		for (size_t i = 0; i < length; ++i)
+		{
+			char value = "01X"[prnGen() % 3];
+			if ((value == 'X') && (dontCares == 8))
+			{	// keep the number of concrete symbols small
+				value = '1';
+			}
+
+			dontCares += (value == 'X')? 1 : 0;
+
+			lhsStr += value;
+			rhsStr += (prnGen() % 4 == 0)? "01X"[prnGen() % 3] : value;
+		}
+
+		VarAsgn lhs(lhsStr);
+		VarAsgn rhs(rhsStr);
+		BOOST_CHECK_EQUAL(lhs.ToString(), lhsStr);
+		BOOST_CHECK_EQUAL(lhs.GetDontCareCount(), dontCares);
+
+		// the lazy expansion matches the concrete symbols in order
+		std::vector<std::string> expected(1, lhsStr);
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (lhsStr[i] == 'X')
+			{
+				std::vector<std::string> expanded;
+				for (std::string str : expected)
+				{
+					str[i] = '0';
+					expanded.push_back(str);
+					str[i] = '1';
+					expanded.push_back(str);
+				}
+
+				expected = expanded;
+			}
+		}
+
+		std::vector<std::string> concrete;
+		for (const VarAsgn& symbol : lhs.GetConcreteSymbols())
+		{
+			concrete.push_back(symbol.ToString());
+		}
+
+		BOOST_CHECK(concrete == expected);
+
+		// word-parallel comparison agrees with comparing the values
+		bool less = false;
+		for (size_t i = length; i > 0; --i)
+		{
+			if (lhsStr[i - 1] != rhsStr[i - 1])
+			{
+				less = rank(lhsStr[i - 1]) < rank(rhsStr[i - 1]);
+				break;
+			}
+		}
+
+		BOOST_CHECK_EQUAL(lhs < rhs, less);
+		BOOST_CHECK_EQUAL(lhs == rhs, lhsStr == rhsStr);
+
+		// intersection matches the values variable by variable
+		std::string isectStr;
+		bool nonempty = true;
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (lhsStr[i] == 'X')
+			{
+				isectStr += rhsStr[i];
+			}
+			else if ((rhsStr[i] == 'X') || (rhsStr[i] == lhsStr[i]))
+			{
+				isectStr += lhsStr[i];
+			}
+			else
+			{
+				nonempty = false;
+			}
+		}
+
+		VarAsgn isect;
+		BOOST_CHECK_EQUAL(VarAsgn::Intersection(lhs, rhs, isect), nonempty);
+		if (nonempty)
+		{
+			BOOST_CHECK_EQUAL(isect.ToString(), isectStr);
+		}
+
+		// symbols given by numbers
+		size_t n = (static_cast<size_t>(prnGen()) << 32) | prnGen();
+		VarAsgn number(length, n);
+		for (size_t i = 0; i < length; ++i)
+		{
+			BOOST_CHECK_EQUAL(number.GetIthVariableValue(i),
+				((i < 64) && ((n >> i) & 1))? VarAsgn::ONE : VarAsgn::ZERO);
+		}
+	}
+
+	VarAsgn extended("10X");
+	extended.AddVariablesUpTo(70);
+	BOOST_CHECK_EQUAL(extended.ToString(), "10X" + std::string(68, 'X'));
+}
+
+
+BOOST_AUTO_TEST_CASE(assignment_visiting)
+{
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	MTBDD bdd = createMTBDDForTestCases(testCases);
+
+	VarAsgn::AssignmentList collected = bdd.GetAllAssignments();
+	VarAsgn::AssignmentList visited;
+	bdd.ForEachAssignment([&visited, &bdd](const VarAsgn& asgn)
+	{	// every visited path leads to a value other than the default one
+		BOOST_CHECK(bdd.GetValue(asgn) != bdd.GetDefaultValue());
+		visited.push_back(asgn);
+	}, 100);
+
+	BOOST_REQUIRE_EQUAL(visited.size(), collected.size());
+	for (size_t i = 0; i < visited.size(); ++i)
+	{	// the assignments are only extended to the requested length
+		BOOST_CHECK_EQUAL(visited[i].length(), 100);
+		BOOST_CHECK_EQUAL(visited[i].ToString().substr(0, collected[i].length()),
+			collected[i].ToString());
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(interned_set_leaves)
+{
+	typedef VATA::Util::InternedSet<unsigned> InternedSet;
+	typedef InternedSet::SetType SetType;
+	typedef OndriksMTBDD<InternedSet> SetMTBDD;
+
+	GCC_DIAG_OFF(effc++)
+	class UnionApplyFunctor :
+		public Apply2Functor<UnionApplyFunctor, InternedSet, InternedSet,
+		InternedSet>
+	{
+	GCC_DIAG_ON(effc++)
+	public:
+
+		InternedSet ApplyOperation(const InternedSet& lhs, const InternedSet& rhs)
+		{
+			return lhs.Union(rhs);
+		}
+	};
+
+	InternedSet empty;
+	InternedSet a(SetType({1, 3, 5}));
+	InternedSet b(SetType({5, 3, 1}));
+	InternedSet c(SetType({2, 3}));
+
+	// equal sets are interned to the same ID
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(InternedSet(SetType()) == empty);
+	BOOST_CHECK_EQUAL(a.GetId(), b.GetId());
+	BOOST_CHECK(a != c);
+
+	BOOST_CHECK(a.Union(c) == InternedSet(SetType({1, 2, 3, 5})));
+	BOOST_CHECK(a.Union(c) == c.Union(a));
+	BOOST_CHECK(a.Union(empty) == a);
+	BOOST_CHECK(a.Intersection(c) == InternedSet(3u));
+	BOOST_CHECK(a.Intersection(InternedSet(SetType({2, 4}))).empty());
+	BOOST_CHECK(InternedSet(3u).IsSubsetOf(c));
+	BOOST_CHECK(!a.IsSubsetOf(c));
+	BOOST_CHECK(!a.HaveEmptyIntersection(c));
+	BOOST_CHECK_EQUAL(Convert::ToString(c), Convert::ToString(c.Get()));
+
+	// leaves of MTBDDs
+	SetMTBDD lhs(VarAsgn("1X0"), a, empty);
+	SetMTBDD rhs(VarAsgn("1XX"), c, empty);
+
+	UnionApplyFunctor unionFunc;
+	SetMTBDD result = unionFunc(lhs, rhs);
+	BOOST_CHECK(result.GetValue(VarAsgn("110")) == a.Union(c));
+	BOOST_CHECK(result.GetValue(VarAsgn("111")) == c);
+	BOOST_CHECK(result.GetValue(VarAsgn("011")) == empty);
+}
+
+
+BOOST_AUTO_TEST_CASE(interned_set_threads)
+{
+	typedef VATA::Util::InternedSet<unsigned> InternedSet;
+	typedef InternedSet::SetType SetType;
+
+	InternedSet a(SetType({1, 3, 5}));
+	InternedSet c(SetType({2, 3}));
+	const SetType mainUnion = a.Union(c).Get();
+
+	// sets are exchanged between threads as plain sets
+	const SetType aSet = a.Get();
+	const SetType cSet = c.Get();
+
+	size_t workerInitCount = 0;
+	SetType workerUnion;
+	InternedSet::IdType workerId = 0;
+	std::thread worker([&]()
+	{
+		// the worker starts with its own store containing just the empty set
+		workerInitCount = InternedSet::GetSetCount();
+
+		InternedSet other(SetType({7, 8, 9}));
+		InternedSet workerA(aSet);
+		InternedSet workerC(cSet);
+
+		workerId = workerA.GetId();
+		workerUnion = workerA.Union(workerC).Get();
+		(void)other;
+	});
+	worker.join();
+
+	BOOST_CHECK_EQUAL(workerInitCount, 1);
+	BOOST_CHECK(workerUnion == mainUnion);
+
+	// the IDs of the worker are meaningless in this thread
+	BOOST_CHECK(workerId != a.GetId());
+}
+
+
+BOOST_AUTO_TEST_CASE(interned_set_reset)
+{
+	typedef VATA::Util::InternedSet<unsigned> InternedSet;
+	typedef InternedSet::SetType SetType;
+
+	const unsigned SET_CNT = 256;
+	const size_t PAIR_CNT = SET_CNT * (SET_CNT - 1) / 2;
+
+	bool opsCorrect = true;
+	size_t countBeforeReset = 0;
+	size_t countAfterReset = 0;
+	size_t countAfterOps = 0;
+	bool opsCorrectAfterReset = false;
+
+	// reset a store of a fresh thread so that no live sets are invalidated
+	std::thread worker([&]()
+	{
+		std::vector<InternedSet> singletons;
+		for (unsigned i = 0; i < SET_CNT; ++i)
+		{
+			singletons.push_back(InternedSet(i));
+		}
+
+		// more distinct pairs than cached entries, so results get evicted
+		for (size_t round = 0; round < 2; ++round)
+		{
+			for (unsigned i = 0; i < SET_CNT; ++i)
+			{
+				for (unsigned j = i + 1; j < SET_CNT; ++j)
+				{
+					InternedSet un = singletons[i].Union(singletons[j]);
+					opsCorrect = opsCorrect &&
+						(un == InternedSet(SetType({i, j}))) &&
+						singletons[i].Intersection(singletons[j]).empty() &&
+						(un.Intersection(singletons[j]) == singletons[j]);
+				}
+			}
+		}
+
+		countBeforeReset = InternedSet::GetSetCount();
+
+		singletons.clear();
+		InternedSet::Reset();
+		countAfterReset = InternedSet::GetSetCount();
+
+		InternedSet a(SetType({1, 3, 5}));
+		InternedSet c(SetType({2, 3}));
+		opsCorrectAfterReset = InternedSet(SetType()).empty() &&
+			(a.Union(c) == InternedSet(SetType({1, 2, 3, 5}))) &&
+			(a.Intersection(c) == InternedSet(3u));
+		countAfterOps = InternedSet::GetSetCount();
+	});
+	worker.join();
+
+	BOOST_CHECK(opsCorrect);
+	BOOST_CHECK_EQUAL(countBeforeReset, 1 + SET_CNT + PAIR_CNT);
+	BOOST_CHECK_EQUAL(countAfterReset, 1);
+	BOOST_CHECK(opsCorrectAfterReset);
+	BOOST_CHECK_EQUAL(countAfterOps, 5);
+}
+
+
+BOOST_AUTO_TEST_CASE(export_import)
+{
+	typedef OndriksMTBDD<unsigned> UnsignedMTBDD;
+	typedef UnsignedMTBDD::ExportedMTBDD<std::string> ExportedMTBDD;
+
+	UnsignedMTBDD first(VarAsgn("1X0"), 3, 0);
+	UnsignedMTBDD second(VarAsgn("01X"), 7, 0);
+
+	GCC_DIAG_OFF(effc++)
+	class MaxApplyFunctor :
+		public Apply2Functor<MaxApplyFunctor, unsigned, unsigned, unsigned>
+	{
+	GCC_DIAG_ON(effc++)
+	public:
+
+		unsigned ApplyOperation(unsigned lhs, unsigned rhs)
+		{
+			return (lhs > rhs)? lhs : rhs;
+		}
+	};
+
+	MaxApplyFunctor maxFunc;
+	UnsignedMTBDD bdd = maxFunc(first, second);
+
+	ExportedMTBDD exported = bdd.Export<std::string>(
+		[](unsigned value){ return Convert::ToString(value); });
+
+	// the root is the last node, children precede their parents
+	BOOST_REQUIRE(!exported.nodes.empty());
+	for (size_t i = 0; i < exported.nodes.size(); ++i)
+	{
+		if (!exported.nodes[i].isLeaf)
+		{
+			BOOST_CHECK(exported.nodes[i].low < i);
+			BOOST_CHECK(exported.nodes[i].high < i);
+		}
+	}
+	BOOST_CHECK_EQUAL(exported.defaultValue, "0");
+
+	UnsignedMTBDD imported = UnsignedMTBDD::Import(exported,
+		[](const std::string& str){ return Convert::FromString<unsigned>(str); });
+
+	BOOST_CHECK(imported == bdd);
+	BOOST_CHECK_EQUAL(imported.GetValue(VarAsgn("100")), 3u);
+	BOOST_CHECK_EQUAL(imported.GetValue(VarAsgn("010")), 7u);
+	BOOST_CHECK_EQUAL(imported.GetValue(VarAsgn("111")), 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE(bulk_build)
+{
+	typedef OndriksMTBDD<unsigned> UnsignedMTBDD;
+
+	GCC_DIAG_OFF(effc++)
+	class OrApplyFunctor :
+		public Apply2Functor<OrApplyFunctor, unsigned, unsigned, unsigned>
+	{
+	GCC_DIAG_ON(effc++)
+	public:
+
+		unsigned ApplyOperation(unsigned lhs, unsigned rhs)
+		{
+			return lhs | rhs;
+		}
+	};
+
+	const char* asgns[] = {"0110", "X01X", "1111", "0110", "XXXX", "10X1", "0001"};
+
+	UnsignedMTBDD::AsgnValueList asgnValueList;
+	OrApplyFunctor orFunc;
+	UnsignedMTBDD unitedBdd(0u);
+	for (size_t i = 0; i < sizeof(asgns) / sizeof(asgns[0]); ++i)
+	{
+		asgnValueList.push_back(std::make_pair(VarAsgn(asgns[i]), 1u << i));
+
+		// the reference result is the union of single-path MTBDDs
+		UnsignedMTBDD bulkBdd = UnsignedMTBDD::Build(asgnValueList, 0u,
+			[](unsigned lhs, unsigned rhs){ return lhs | rhs; });
+		unitedBdd = orFunc(unitedBdd, UnsignedMTBDD(VarAsgn(asgns[i]), 1u << i, 0u));
+
+		BOOST_CHECK(bulkBdd == unitedBdd);
+	}
+
+	UnsignedMTBDD emptyBdd = UnsignedMTBDD::Build(UnsignedMTBDD::AsgnValueList(),
+		5u, [](unsigned lhs, unsigned rhs){ return lhs | rhs; });
+	BOOST_CHECK(emptyBdd == UnsignedMTBDD(5u));
+
+	// don't cares at different positions: the i-th assignment has the only
+	// ONE at the position i, so the assignments split into 2^k distinct parts
+	for (size_t k : {8, 40})
+	{
+		UnsignedMTBDD::AsgnValueList oneHotList;
+		UnsignedMTBDD oneHotUnited(0u);
+		for (size_t i = 0; i < k; ++i)
+		{
+			std::string asgn(k, 'X');
+			asgn[i] = '1';
+
+			// distinct values for the small case, a compact result for the big one
+			unsigned value = (k <= 8)? (1u << i) : 1u;
+			oneHotList.push_back(std::make_pair(VarAsgn(asgn), value));
+			oneHotUnited = orFunc(oneHotUnited, UnsignedMTBDD(VarAsgn(asgn), value, 0u));
+		}
+
+		UnsignedMTBDD oneHotBdd = UnsignedMTBDD::Build(oneHotList, 0u,
+			[](unsigned lhs, unsigned rhs){ return lhs | rhs; });
+
+		BOOST_CHECK_MESSAGE(oneHotBdd == oneHotUnited,
+			"Bulk build of " + Convert::ToString(k) + " one-hot assignments failed");
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(and_exists)
+{
+	typedef OndriksMTBDD<bool> BoolMTBDD;
+
+	GCC_DIAG_OFF(effc++)
+	class OddApplyFunctor :
+		public Apply1Functor<OddApplyFunctor, DataType, bool>
+	{
+	GCC_DIAG_ON(effc++)
+
+	public:
+
+		inline bool ApplyOperation(const DataType& val)
+		{
+			return 0 != (val % 2);
+		}
+	};
+
+	GCC_DIAG_OFF(effc++)
+	class NonzeroApplyFunctor :
+		public Apply1Functor<NonzeroApplyFunctor, DataType, bool>
+	{
+	GCC_DIAG_ON(effc++)
+
+	public:
+
+		inline bool ApplyOperation(const DataType& val)
+		{
+			return 0 != val;
+		}
+	};
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	MTBDD bdd = createMTBDDForTestCases(testCases);
+
+	// the operands share some variables and differ in others
+	OddApplyFunctor oddFunc;
+	BoolMTBDD lhs = oddFunc(bdd);
+	NonzeroApplyFunctor nonzeroFunc;
+	BoolMTBDD rhs = nonzeroFunc(bdd.Rename([](size_t var){ return var + 1; }));
+
+	VATA::MTBDDPkg::AndApplyFunctor andFunc;
+	BoolMTBDD conjunction = andFunc(lhs, rhs);
+
+	// variables are numbered from the leaves, so the top ones are the highest;
+	// the renaming of rhs uses one more variable
+	const size_t x3 = this->translateVarNameToIndex("x3");
+	const size_t varCnt = this->getVarCount() + 1;
+
+	std::vector<std::function<bool(size_t)>> predicates = {
+		[](size_t){ return false; },
+		[](size_t){ return true; },
+		[x3](size_t var){ return x3 == var; },
+		[varCnt](size_t var){ return var >= varCnt / 2; },
+		[varCnt](size_t var){ return var + 1 == varCnt; },
+		[varCnt](size_t var){ return var < varCnt / 2; }
+	};
+
+	for (size_t i = 0; i < predicates.size(); ++i)
+	{
+		VATA::MTBDDPkg::OrApplyFunctor orFunc;
+		BoolMTBDD expected = conjunction.Project(predicates[i], orFunc);
+
+		VATA::MTBDDPkg::AndExistsFunctor<std::function<bool(size_t)>>
+			andExistsFunc(predicates[i]);
+		BoolMTBDD result = andExistsFunc(lhs, rhs);
+
+		// nodes are hash-consed, so equal MTBDDs have the same root
+		BOOST_CHECK_MESSAGE(expected == result,
+			"AndExists differs from And and Project for predicate " +
+			Convert::ToString(i));
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()